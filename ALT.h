@@ -0,0 +1,229 @@
+#ifndef ALT_H
+#define ALT_H
+
+#include "Algorithms.h"
+#include "BinaryHeap.h"
+#include "GraphGenerators.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+using std::vector;
+
+// ALT (A*, landmarks, triangle inequality) for repeated s-t queries on one fixed
+// graph. preprocessing picks k landmarks and stores d(L, v) (and d(v, L) on directed
+// graphs) for every vertex; a query runs A* with the potential
+//   h(v) = max over L of d(L, t) - d(L, v) and d(v, L) - d(t, L)
+// which never overestimates d(v, t) and is consistent, so a vertex is final when
+// settled and the query stops at t like runPointToPoint.
+class ALT {
+public:
+    enum Selection { FARTHEST, AVOID };
+
+    static const char* selectionName(Selection s) { return s == FARTHEST ? "farthest" : "avoid"; }
+
+    int numVertices;
+    int k;
+    bool symmetric;  // reverse is g itself: d(v, L) = d(L, v), one table
+    vector<int> landmarks;
+
+    // reverse: transpose of g, or g itself for undirected graphs. FARTHEST: each new
+    // landmark is the reachable vertex farthest from the chosen ones (the first is
+    // farthest from a random vertex). AVOID (goldberg & harrelson): grow a shortest-
+    // path tree from a random root, weight each vertex by how badly the current
+    // landmarks bound its distance from the root, and walk to the leaf of the
+    // heaviest subtree that holds no landmark yet. seed fixes the random vertices.
+    template <typename GraphT, typename ReverseT>
+    ALT(const GraphT& g, const ReverseT& reverse, int numLandmarks, Selection selection, uint64_t seed)
+        : numVertices(g.numVertices), k(0),
+          symmetric((const void*)&g == (const void*)&reverse) {
+        int n = numVertices;
+        int want = std::min(numLandmarks, n);
+        CounterRNG rng(seed, 3);
+        BinaryHeap<int> bh(n);
+        QueryWorkspace<BinaryHeap<int>> ws(n);
+        Columns cols;
+        cols.nearest.assign(n, INF);
+        // a root can fail to yield a landmark (isolated, or its tree is covered); draw again
+        for (uint64_t draw = 0; (int)cols.from.size() < want && draw < 4 * (uint64_t)want + 4; draw++) {
+            int root = (int)CounterRNG::below((uint32_t)rng.at(draw), (uint32_t)n);
+            int next = selection == FARTHEST ? farthest(g, root, bh, cols) : avoid(g, root, ws, cols);
+            if (next >= 0) addLandmark(g, reverse, next, bh, cols);
+        }
+
+        // vertex-major, so one query vertex reads k adjacent entries
+        k = (int)cols.from.size();
+        from.resize((size_t)n * k);
+        if (!symmetric) to.resize((size_t)n * k);
+        for (int l = 0; l < k; l++) {
+            for (int v = 0; v < n; v++) {
+                from[(size_t)v * k + l] = cols.from[l][v];
+                if (!symmetric) to[(size_t)v * k + l] = cols.to[l][v];
+            }
+        }
+    }
+
+    size_t tableBytes() const { return (from.size() + to.size()) * sizeof(int); }
+
+    // lower bound on d(v, t)
+    int lowerBound(int v, int t) const {
+        const int* fv = &from[(size_t)v * k];
+        const int* ft = &from[(size_t)t * k];
+        const int* tv = symmetric ? fv : &to[(size_t)v * k];
+        const int* tt = symmetric ? ft : &to[(size_t)t * k];
+        int best = 0;
+        for (int l = 0; l < k; l++) {
+            if (fv[l] != INF && ft[l] != INF) best = std::max(best, ft[l] - fv[l]);
+            if (tv[l] != INF && tt[l] != INF) best = std::max(best, tv[l] - tt[l]);
+        }
+        return best;
+    }
+
+    // A* from source to target on g (the graph the tables were built on); keys are
+    // dist + lowerBound. returns dist(target), INF if unreachable; ws.pathTo(target)
+    // gives the path. works with any heap that accepts the keys: consistent
+    // potentials keep them monotone, but a key can run up to 2 * maxEdgeWeight past
+    // the last one extracted, beyond a default DialQueue's range.
+    template <typename GraphT, typename HeapT>
+    int query(const GraphT& g, int source, int target, QueryWorkspace<HeapT>& ws) const {
+        static_assert(IsPriorityQueue<HeapT, int>::value,
+                      "ALT::query: heap needs insert(int, T), extractMin(int&, T&), decreaseKey(T, int), isEmpty()");
+        HeapT& pq = ws.heap;
+        ws.begin();
+        ws.setDist(source, 0, -1);
+        pq.insert(lowerBound(source, target), source);
+        ws.markQueued(source);
+
+        while (!pq.isEmpty()) {
+            int key, u;
+            pq.extractMin(key, u);
+            if (ws.settled(u)) continue;
+            ws.markSettled(u);
+            if (u == target) break;
+            int d = ws.dist(u);
+            for (const auto& edge : g.neighbors(u)) {
+                int v = edge.target;
+                int newDist = d + edge.weight;
+                if (ws.settled(v) || newDist >= ws.dist(v)) continue;
+                ws.setDist(v, newDist, u);
+                int newKey = newDist + lowerBound(v, target);
+                if (ws.queued(v))
+                    pq.decreaseKey(v, newKey);
+                else {
+                    pq.insert(newKey, v);
+                    ws.markQueued(v);
+                }
+            }
+        }
+        return ws.dist(target);
+    }
+
+private:
+    vector<int> from;  // d(L, v) at v * k + l
+    vector<int> to;    // d(v, L) at v * k + l, empty when symmetric
+
+    // landmark-major distance columns while landmarks are being chosen
+    struct Columns {
+        vector<vector<int>> from;
+        vector<vector<int>> to;
+        vector<int> nearest;  // min over chosen landmarks of d(L, v)
+
+        // lower bound on d(u, v) from the columns so far
+        int lowerBound(int u, int v, bool symmetric) const {
+            int best = 0;
+            for (size_t l = 0; l < from.size(); l++) {
+                const vector<int>& t = symmetric ? from[l] : to[l];
+                if (from[l][u] != INF && from[l][v] != INF) best = std::max(best, from[l][v] - from[l][u]);
+                if (t[u] != INF && t[v] != INF) best = std::max(best, t[u] - t[v]);
+            }
+            return best;
+        }
+    };
+
+    template <typename GraphT, typename ReverseT>
+    void addLandmark(const GraphT& g, const ReverseT& reverse, int L, BinaryHeap<int>& bh, Columns& cols) {
+        landmarks.push_back(L);
+        cols.from.emplace_back();
+        Algorithms::runDijkstra(g, L, bh, cols.from.back());
+        if (!symmetric) {
+            cols.to.emplace_back();
+            Algorithms::runDijkstra(reverse, L, bh, cols.to.back());
+        }
+        const vector<int>& d = cols.from.back();
+        for (int v = 0; v < numVertices; v++) cols.nearest[v] = std::min(cols.nearest[v], d[v]);
+    }
+
+    // reachable vertex maximizing the distance to the nearest landmark (from root
+    // when there is none yet); -1 if there is no such vertex at positive distance
+    template <typename GraphT>
+    int farthest(const GraphT& g, int root, BinaryHeap<int>& bh, const Columns& cols) const {
+        vector<int> rootDist;
+        const vector<int>* d = &cols.nearest;
+        if (cols.from.empty()) {
+            Algorithms::runDijkstra(g, root, bh, rootDist);
+            d = &rootDist;
+        }
+        int best = -1, bestDist = 0;
+        for (int v = 0; v < numVertices; v++) {
+            if ((*d)[v] != INF && (*d)[v] > bestDist) {
+                best = v;
+                bestDist = (*d)[v];
+            }
+        }
+        return best;
+    }
+
+    // avoid heuristic on the shortest-path tree of root
+    template <typename GraphT, typename HeapT>
+    int avoid(const GraphT& g, int root, QueryWorkspace<HeapT>& ws, const Columns& cols) const {
+        Algorithms::runDijkstra(g, root, ws);
+        const vector<int>& reached = ws.touched();
+        int m = (int)reached.size();
+        vector<int> index(numVertices, -1);
+        for (int i = 0; i < m; i++) index[reached[i]] = i;
+
+        // children lists of the tree (counting sort by parent), then a preorder
+        vector<int> childStart(m + 1, 0), children(m > 0 ? m - 1 : 0);
+        for (int i = 0; i < m; i++)
+            if (ws.parent(reached[i]) >= 0) childStart[index[ws.parent(reached[i])] + 1]++;
+        for (int i = 0; i < m; i++) childStart[i + 1] += childStart[i];
+        vector<int> cursor(childStart.begin(), childStart.end() - 1);
+        for (int i = 0; i < m; i++)
+            if (ws.parent(reached[i]) >= 0) children[cursor[index[ws.parent(reached[i])]]++] = i;
+        vector<int> preorder, stack(1, index[root]);
+        preorder.reserve(m);
+        while (!stack.empty()) {
+            int i = stack.back();
+            stack.pop_back();
+            preorder.push_back(i);
+            for (int c = childStart[i]; c < childStart[i + 1]; c++) stack.push_back(children[c]);
+        }
+
+        // size = subtree sum of d(root, v) - lowerBound(root, v); 0 under a landmark
+        vector<long long> size(m);
+        vector<char> holdsLandmark(m, 0);
+        for (int L : landmarks)
+            if (index[L] >= 0) holdsLandmark[index[L]] = 1;
+        for (int p = m - 1; p >= 0; p--) {
+            int i = preorder[p];
+            int v = reached[i];
+            size[i] += ws.dist(v) - cols.lowerBound(root, v, symmetric);
+            for (int c = childStart[i]; c < childStart[i + 1]; c++) {
+                size[i] += size[children[c]];
+                if (holdsLandmark[children[c]]) holdsLandmark[i] = 1;
+            }
+            if (holdsLandmark[i]) size[i] = 0;
+        }
+
+        // descend from the root (whose own subtree holds every landmark it reaches)
+        int i = index[root];
+        while (true) {
+            int best = -1;
+            for (int c = childStart[i]; c < childStart[i + 1]; c++)
+                if (size[children[c]] > 0 && (best < 0 || size[children[c]] > size[best])) best = children[c];
+            if (best < 0) return i == index[root] ? -1 : reached[i];
+            i = best;
+        }
+    }
+};
+
+#endif
@@ -3,43 +3,89 @@
 
 #include "Graph.h"
 #include "PriorityQueue.h"
+#include "QueryWorkspace.h"
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <type_traits>
 
 using std::vector;
 
 const int INF = std::numeric_limits<int>::max();
 
+// per-query flags for runDijkstra; callers running many queries keep one
+// so the vectors are allocated once
+struct DijkstraScratch {
+    vector<char> inPQ;
+    vector<char> visited;
+
+    void reset(int n) {
+        inPQ.assign(n, 0);
+        visited.assign(n, 0);
+    }
+};
+
 class Algorithms {
 public:
-    // dijkstra: insert when first seen, decreaseKey if already in pq
-    static void runDijkstra(const Graph& g, int startNode, PriorityQueue<int>* pq, vector<int>& dist) {
+    // GraphT: Graph or CSRGraph (anything with numVertices and neighbors(u)).
+    // PriorityQueue<int>* overloads dispatch virtually (any heap at runtime);
+    // PQ& overloads take the concrete (final) heap type so every call inlines.
+
+    template <typename GraphT>
+    static void runDijkstra(const GraphT& g, int startNode, PriorityQueue<int>* pq, vector<int>& dist) {
+        runDijkstra(g, startNode, *pq, dist);
+    }
+
+    template <typename GraphT>
+    static void runPrim(const GraphT& g, int startNode, PriorityQueue<int>* pq,
+                        vector<int>& minEdge, int& totalWeight) {
+        runPrim(g, startNode, *pq, minEdge, totalWeight);
+    }
+
+    // dijkstra: insert when first seen, decreaseKey if already in pq.
+    // D: distance type, int or long long (INF = its max); the heap's keys are D
+    // (BinaryHeap<int, long long>, DaryHeap<int, 8, long long>, ...)
+    template <typename GraphT, typename PQ, typename D, typename = std::enable_if_t<!std::is_pointer<PQ>::value>>
+    static void runDijkstra(const GraphT& g, int startNode, PQ& pq, vector<D>& dist) {
+        dist.resize(g.numVertices);
+        DijkstraScratch scratch;
+        runDijkstra(g, startNode, pq, dist.data(), scratch);
+    }
+
+    // same, writing dist[0..n) in place and reusing scratch across calls
+    // (callers running many queries, e.g. BatchDijkstra rows)
+    template <typename GraphT, typename PQ, typename D, typename = std::enable_if_t<!std::is_pointer<PQ>::value>>
+    static void runDijkstra(const GraphT& g, int startNode, PQ& pq, D* dist, DijkstraScratch& scratch) {
+        static_assert(IsPriorityQueue<PQ, int, D>::value,
+                      "runDijkstra: heap needs insert(D, T), extractMin(D&, T&), decreaseKey(T, D), isEmpty()");
         int n = g.numVertices;
-        dist.assign(n, INF);
+        std::fill(dist, dist + n, std::numeric_limits<D>::max());
         dist[startNode] = 0;
-        vector<bool> inPQ(n, false);
-        vector<bool> visited(n, false);
+        scratch.reset(n);
+        vector<char>& inPQ = scratch.inPQ;
+        vector<char>& visited = scratch.visited;
 
-        pq->insert(0, startNode);
+        pq.insert(0, startNode);
         inPQ[startNode] = true;
 
-        while (!pq->isEmpty()) {
-            int d, u;
-            pq->extractMin(d, u);
+        while (!pq.isEmpty()) {
+            D d;
+            int u;
+            pq.extractMin(d, u);
             inPQ[u] = false;
             if (visited[u]) continue;
             visited[u] = true;
             // relax edges out of u
-            for (const auto& edge : g.adjList[u]) {
+            for (const auto& edge : g.neighbors(u)) {
                 int v = edge.target;
                 int weight = edge.weight;
-                int newDist = dist[u] + weight;
+                D newDist = dist[u] + weight;
                 if (!visited[v] && newDist < dist[v]) {
                     dist[v] = newDist;
                     if (inPQ[v])
-                        pq->decreaseKey(v, dist[v]);
+                        pq.decreaseKey(v, dist[v]);
                     else {
-                        pq->insert(dist[v], v);
+                        pq.insert(dist[v], v);
                         inPQ[v] = true;
                     }
                 }
@@ -47,41 +93,234 @@ public:
         }
     }
 
+    // same search on a reused workspace: no O(n) setup, cost follows the vertices
+    // reached. results stay in ws (ws.dist(v), ws.parent(v), ws.touched()) until the next query.
+    template <typename GraphT, typename HeapT>
+    static void runDijkstra(const GraphT& g, int startNode, QueryWorkspace<HeapT>& ws) {
+        search(g, startNode, -1, ws);
+    }
+
+    // s-t query: stops as soon as target is settled. returns dist(target), INF if
+    // unreachable; ws.pathTo(target, path) gives the path. vertices still queued at
+    // the stop keep tentative distances.
+    template <typename GraphT, typename HeapT>
+    static int runPointToPoint(const GraphT& g, int source, int target, QueryWorkspace<HeapT>& ws) {
+        search(g, source, target, ws);
+        return ws.dist(target);
+    }
+
+    // bidirectional s-t query: forward search from source on g, backward search from
+    // target on reverse (g itself for undirected graphs), one settle each in turn.
+    // mu is the best s-t distance seen across the frontiers (updated whenever an edge
+    // reaches a vertex the other side has reached); the search stops once the key
+    // extracted on one side plus the last key extracted on the other is >= mu (the
+    // usual top_f + top_b >= mu rule, with the other side's last key as a lower bound
+    // for its top). returns the distance, INF if unreachable; meet is a vertex on a
+    // shortest path (-1 if none), for bidirectionalPath.
+    template <typename GraphT, typename ReverseT, typename HeapT>
+    static int runBidirectional(const GraphT& g, const ReverseT& reverse, int source, int target,
+                                QueryWorkspace<HeapT>& fwd, QueryWorkspace<HeapT>& bwd, int& meet) {
+        static_assert(IsPriorityQueue<HeapT, int>::value,
+                      "runBidirectional: heap needs insert(int, T), extractMin(int&, T&), decreaseKey(T, int), isEmpty()");
+        fwd.begin();
+        bwd.begin();
+        meet = -1;
+        fwd.setDist(source, 0, -1);
+        fwd.heap.insert(0, source);
+        fwd.markQueued(source);
+        bwd.setDist(target, 0, -1);
+        bwd.heap.insert(0, target);
+        bwd.markQueued(target);
+        int mu = source == target ? 0 : INF;
+        if (source == target) meet = source;
+        int lastF = 0, lastB = 0;  // keys extracted last, lower bounds for each side's top
+
+        bool forward = true;
+        while (!fwd.heap.isEmpty() || !bwd.heap.isEmpty()) {
+            if (fwd.heap.isEmpty()) forward = false;
+            else if (bwd.heap.isEmpty()) forward = true;
+            QueryWorkspace<HeapT>& ws = forward ? fwd : bwd;
+            QueryWorkspace<HeapT>& other = forward ? bwd : fwd;
+            int d, u;
+            ws.heap.extractMin(d, u);
+            if (!ws.settled(u)) {
+                if ((long long)d + (forward ? lastB : lastF) >= mu) break;
+                (forward ? lastF : lastB) = d;
+                ws.markSettled(u);
+                if (forward) relaxBidirectional(g, u, d, ws, other, mu, meet);
+                else relaxBidirectional(reverse, u, d, ws, other, mu, meet);
+            }
+            forward = !forward;
+        }
+        return mu;
+    }
+
+    // source..target through the meeting vertex of runBidirectional
+    template <typename HeapT>
+    static bool bidirectionalPath(const QueryWorkspace<HeapT>& fwd, const QueryWorkspace<HeapT>& bwd, int meet,
+                                  vector<int>& path) {
+        path.clear();
+        if (meet < 0 || !fwd.pathTo(meet, path)) return false;
+        for (int u = bwd.parent(meet); u != -1; u = bwd.parent(u))
+            path.push_back(u);
+        return true;
+    }
+
     // prim: minEdge[v] = min edge weight into current MST
-    static void runPrim(const Graph& g, int startNode, PriorityQueue<int>* pq,
+    template <typename GraphT, typename PQ, typename = std::enable_if_t<!std::is_pointer<PQ>::value>>
+    static void runPrim(const GraphT& g, int startNode, PQ& pq,
                         vector<int>& minEdge, int& totalWeight) {
+        static_assert(IsPriorityQueue<PQ, int>::value,
+                      "runPrim: heap needs insert(int, T), extractMin(int&, T&), decreaseKey(T, int), isEmpty()");
         int n = g.numVertices;
         minEdge.assign(n, INF);
         minEdge[startNode] = 0;
         vector<bool> inPQ(n, false);
         vector<bool> inMST(n, false);
 
-        pq->insert(0, startNode);
+        pq.insert(0, startNode);
         inPQ[startNode] = true;
         totalWeight = 0;
 
-        while (!pq->isEmpty()) {
+        while (!pq.isEmpty()) {
             int key, u;
-            pq->extractMin(key, u);
+            pq.extractMin(key, u);
             inPQ[u] = false;
             if (inMST[u]) continue;  // duplicate extract, skip
             inMST[u] = true;
             totalWeight += key;
-            for (const auto& edge : g.adjList[u]) {
+            for (const auto& edge : g.neighbors(u)) {
                 int v = edge.target;
                 int w = edge.weight;
                 if (!inMST[v] && w < minEdge[v]) {
                     minEdge[v] = w;
                     if (inPQ[v])
-                        pq->decreaseKey(v, minEdge[v]);
+                        pq.decreaseKey(v, minEdge[v]);
                     else {
-                        pq->insert(minEdge[v], v);
+                        pq.insert(minEdge[v], v);
                         inPQ[v] = true;
                     }
                 }
             }
         }
     }
+
+    // lazy-deletion dijkstra: every improvement inserts a new entry, never decreaseKey;
+    // stale entries (vertex already visited) are skipped as they come out. works with
+    // insert-only heaps (LazyHeap.h, PackedHeap.h) as well as the decreaseKey ones; the
+    // queue can hold up to one entry per relaxation instead of one per vertex. D as in runDijkstra.
+    template <typename GraphT, typename PQ, typename D, typename = std::enable_if_t<!std::is_pointer<PQ>::value>>
+    static void runDijkstraLazy(const GraphT& g, int startNode, PQ& pq, vector<D>& dist) {
+        static_assert(IsInsertOnlyQueue<PQ, int, D>::value,
+                      "runDijkstraLazy: heap needs insert(D, T), extractMin(D&, T&), isEmpty()");
+        int n = g.numVertices;
+        dist.assign(n, std::numeric_limits<D>::max());
+        dist[startNode] = 0;
+        vector<char> visited(n, 0);
+
+        pq.insert(0, startNode);
+        while (!pq.isEmpty()) {
+            D d;
+            int u;
+            pq.extractMin(d, u);
+            if (visited[u]) continue;  // stale entry
+            visited[u] = true;
+            for (const auto& edge : g.neighbors(u)) {
+                int v = edge.target;
+                D newDist = d + edge.weight;
+                if (!visited[v] && newDist < dist[v]) {
+                    dist[v] = newDist;
+                    pq.insert(newDist, v);
+                }
+            }
+        }
+    }
+
+    // lazy-deletion prim, same scheme
+    template <typename GraphT, typename PQ, typename = std::enable_if_t<!std::is_pointer<PQ>::value>>
+    static void runPrimLazy(const GraphT& g, int startNode, PQ& pq, vector<int>& minEdge, int& totalWeight) {
+        static_assert(IsInsertOnlyQueue<PQ, int>::value,
+                      "runPrimLazy: heap needs insert(int, T), extractMin(int&, T&), isEmpty()");
+        int n = g.numVertices;
+        minEdge.assign(n, INF);
+        minEdge[startNode] = 0;
+        vector<char> inMST(n, 0);
+
+        pq.insert(0, startNode);
+        totalWeight = 0;
+        while (!pq.isEmpty()) {
+            int key, u;
+            pq.extractMin(key, u);
+            if (inMST[u]) continue;  // stale entry
+            inMST[u] = true;
+            totalWeight += key;
+            for (const auto& edge : g.neighbors(u)) {
+                int v = edge.target;
+                int w = edge.weight;
+                if (!inMST[v] && w < minEdge[v]) {
+                    minEdge[v] = w;
+                    pq.insert(w, v);
+                }
+            }
+        }
+    }
+
+private:
+    // one side's edge scan in runBidirectional; meeting the other side lowers mu
+    template <typename GraphT, typename HeapT>
+    static void relaxBidirectional(const GraphT& g, int u, int d, QueryWorkspace<HeapT>& ws,
+                                   const QueryWorkspace<HeapT>& other, int& mu, int& meet) {
+        for (const auto& edge : g.neighbors(u)) {
+            int v = edge.target;
+            int newDist = d + edge.weight;
+            if (ws.settled(v) || newDist >= ws.dist(v)) continue;
+            ws.setDist(v, newDist, u);
+            if (ws.queued(v))
+                ws.heap.decreaseKey(v, newDist);
+            else {
+                ws.heap.insert(newDist, v);
+                ws.markQueued(v);
+            }
+            int rest = other.dist(v);
+            if (rest != INF && (long long)newDist + rest < mu) {
+                mu = newDist + rest;
+                meet = v;
+            }
+        }
+    }
+
+    // workspace dijkstra, stopping after target is settled (target -1: settle everything)
+    template <typename GraphT, typename HeapT>
+    static void search(const GraphT& g, int startNode, int target, QueryWorkspace<HeapT>& ws) {
+        static_assert(IsPriorityQueue<HeapT, int>::value,
+                      "runDijkstra: heap needs insert(int, T), extractMin(int&, T&), decreaseKey(T, int), isEmpty()");
+        HeapT& pq = ws.heap;
+        ws.begin();
+        ws.setDist(startNode, 0, -1);
+        pq.insert(0, startNode);
+        ws.markQueued(startNode);
+
+        while (!pq.isEmpty()) {
+            int d, u;
+            pq.extractMin(d, u);
+            if (ws.settled(u)) continue;
+            ws.markSettled(u);
+            if (u == target) return;
+            for (const auto& edge : g.neighbors(u)) {
+                int v = edge.target;
+                int newDist = d + edge.weight;
+                if (!ws.settled(v) && newDist < ws.dist(v)) {
+                    ws.setDist(v, newDist, u);
+                    if (ws.queued(v))
+                        pq.decreaseKey(v, newDist);
+                    else {
+                        pq.insert(newDist, v);
+                        ws.markQueued(v);
+                    }
+                }
+            }
+        }
+    }
 };
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef BATCH_DIJKSTRA_H
+#define BATCH_DIJKSTRA_H
+
+#include "Algorithms.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <memory>
+using std::vector;
+
+// multi-source dijkstra over one graph on a fixed ThreadPool.
+// each worker owns one QueryWorkspace (heap and per-vertex state) for the engine's
+// lifetime, reused for every source without clearing.
+// HeapT is the concrete heap (static dispatch), constructed as HeapT(numVertices).
+template <typename HeapT, typename GraphT = Graph>
+class BatchDijkstra {
+public:
+    BatchDijkstra(const GraphT& graph, ThreadPool& threadPool) : g(graph), pool(threadPool) {
+        for (int i = 0; i < pool.size(); i++)
+            workers.emplace_back(new QueryWorkspace<HeapT>(g.numVertices));
+    }
+
+    // row i of distMatrix (row-major, sources.size() x numVertices) = dist from sources[i].
+    // distMatrix is resized if it is not already that size.
+    void run(const vector<int>& sources, vector<int>& distMatrix) {
+        size_t n = (size_t)g.numVertices;
+        if (distMatrix.size() != sources.size() * n)
+            distMatrix.resize(sources.size() * n);
+        int* rows = distMatrix.data();
+        pool.parallelFor((int)sources.size(), [&](int worker, int i) {
+            QueryWorkspace<HeapT>& ws = *workers[worker];
+            Algorithms::runDijkstra(g, sources[i], ws);
+            ws.copyDist(rows + (size_t)i * n);
+        });
+    }
+
+private:
+    const GraphT& g;
+    ThreadPool& pool;
+    vector<std::unique_ptr<QueryWorkspace<HeapT>>> workers;
+};
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <ostream>
+using std::vector;
+using std::string;
+
+// summary of repeated timings of one measurement (microseconds)
+struct TrialStats {
+    int trials;
+    double minUs;
+    double medianUs;
+    double p95Us;     // nearest rank
+    double meanUs;
+    double ci95Us;    // half-width of the 95% confidence interval of the mean (student t)
+
+    static TrialStats of(vector<double> us) {
+        TrialStats s = { (int)us.size(), 0, 0, 0, 0, 0 };
+        if (us.empty()) return s;
+        std::sort(us.begin(), us.end());
+        size_t n = us.size();
+        s.minUs = us[0];
+        s.medianUs = n % 2 ? us[n / 2] : (us[n / 2 - 1] + us[n / 2]) / 2;
+        s.p95Us = us[(size_t)std::ceil(0.95 * n) - 1];
+        double sum = 0;
+        for (double x : us) sum += x;
+        s.meanUs = sum / n;
+        if (n > 1) {
+            double sq = 0;
+            for (double x : us) sq += (x - s.meanUs) * (x - s.meanUs);
+            double sd = std::sqrt(sq / (n - 1));
+            s.ci95Us = tQuantile975((int)n - 1) * sd / std::sqrt((double)n);
+        }
+        return s;
+    }
+
+    // two-sided 95% student t quantile for df degrees of freedom
+    static double tQuantile975(int df) {
+        static const double table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+        if (df < 1) return 0;
+        if (df <= 30) return table[df - 1];
+        if (df <= 60) return 2.000;
+        if (df <= 120) return 1.980;
+        return 1.960;
+    }
+};
+
+// command line of the benchmark driver. empty name lists select everything;
+// names match case-insensitively.
+struct BenchOptions {
+    vector<string> algos;    // dijkstra, prim, boruvka, filterkruskal
+    vector<string> heaps;    // HeapType column names
+    vector<string> classes;  // random, grid, worst_case
+    vector<int> sizes;
+    vector<string> graphs;   // graph files (.gr, .csrg, else edge list)
+    int warmup;
+    int trials;
+    unsigned seed;
+    bool json;
+    bool sweeps;             // the sweep files (batch_scaling.txt ... keys.txt, see --no-sweeps)
+    string outPath;
+    string traceDir;         // non-empty: record the reference runs as heap traces here
+
+    BenchOptions() : sizes{ 100, 500, 5000, 10000 }, warmup(1), trials(5), seed(42),
+                     json(false), sweeps(true), outPath("results.txt") {}
+
+    static bool sameName(const string& a, const string& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++)
+            if (std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i])) return false;
+        return true;
+    }
+
+    static bool selects(const vector<string>& list, const string& name) {
+        if (list.empty()) return true;
+        for (const string& s : list)
+            if (sameName(s, name)) return true;
+        return false;
+    }
+
+    bool wantAlgo(const string& name) const { return selects(algos, name); }
+    bool wantHeap(const string& name) const { return selects(heaps, name); }
+    // graph files alone replace the generated classes unless --classes asks for them too
+    bool wantClass(const string& name) const { return classes.empty() ? graphs.empty() : selects(classes, name); }
+
+    static void usage(std::ostream& os, const char* prog) {
+        os << "usage: " << prog << " [options]\n"
+           << "  --algos LIST     dijkstra,prim,boruvka,filterkruskal (default all)\n"
+           << "  --heaps LIST     HeapType names, e.g. Binary,8-ary,Dial (default all)\n"
+           << "  --classes LIST   random,grid,worst_case (default all)\n"
+           << "  --sizes LIST     vertex counts (default 100,500,5000,10000)\n"
+           << "  --graph LIST     graph files: DIMACS .gr, binary .csrg (see graphconv), else \"u v [w]\" edge list;\n"
+           << "                   without --classes only these run (no generated graphs, no sweeps)\n"
+           << "  --warmup N       untimed runs per measurement before the trials (default 1)\n"
+           << "  --trials N       timed runs per measurement (default 5)\n"
+           << "  --seed N         graph and ordering seed (default 42)\n"
+           << "  --format F       csv or json (default csv)\n"
+           << "  --out PATH       results file (default results.txt)\n"
+           << "  --no-sweeps      skip all sweep files: batch_scaling.txt, delta_stepping.txt, point_to_point.txt,\n"
+           << "                   alt.txt, ch.txt, dynamic.txt, lazy.txt, reorder.txt, keys.txt\n"
+           << "  --trace-dir DIR  write each graph's Dijkstra/Prim heap operations to DIR/*.trace (see replay)\n";
+    }
+
+    // false (with error set) on a bad option; --help sets error to "help"
+    bool parse(int argc, char** argv, string& error) {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            string value;
+            size_t eq = arg.find('=');
+            bool inlineValue = arg.compare(0, 2, "--") == 0 && eq != string::npos;
+            if (inlineValue) {
+                value = arg.substr(eq + 1);
+                arg = arg.substr(0, eq);
+            }
+            if (arg == "--help" || arg == "-h") {
+                error = "help";
+                return false;
+            }
+            if (arg == "--no-sweeps") {
+                sweeps = false;
+                continue;
+            }
+            if (!inlineValue) {
+                if (i + 1 >= argc) {
+                    error = "missing value for " + arg;
+                    return false;
+                }
+                value = argv[++i];
+            }
+            if (arg == "--algos") algos = split(value);
+            else if (arg == "--heaps") heaps = split(value);
+            else if (arg == "--classes") classes = split(value);
+            else if (arg == "--graph") graphs = split(value);
+            else if (arg == "--sizes") {
+                sizes.clear();
+                for (const string& s : split(value)) {
+                    int n = std::atoi(s.c_str());
+                    if (n < 2) {
+                        error = "bad size " + s;
+                        return false;
+                    }
+                    sizes.push_back(n);
+                }
+            }
+            else if (arg == "--warmup") warmup = std::max(0, std::atoi(value.c_str()));
+            else if (arg == "--trials") trials = std::max(1, std::atoi(value.c_str()));
+            else if (arg == "--seed") seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+            else if (arg == "--out") outPath = value;
+            else if (arg == "--trace-dir") traceDir = value;
+            else if (arg == "--format") {
+                if (value != "csv" && value != "json") {
+                    error = "format must be csv or json";
+                    return false;
+                }
+                json = value == "json";
+            }
+            else {
+                error = "unknown option " + arg;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static vector<string> split(const string& list) {
+        vector<string> out;
+        size_t start = 0;
+        while (start <= list.size()) {
+            size_t comma = list.find(',', start);
+            if (comma == string::npos) comma = list.size();
+            if (comma > start) out.push_back(list.substr(start, comma - start));
+            start = comma + 1;
+        }
+        return out;
+    }
+};
+
+#endif
@@ -8,17 +8,20 @@ using std::vector;
 using std::pair;
 using std::swap;
 
-template <typename T>
-class BinaryHeap : public PriorityQueue<T> {
+// K: key type (PriorityQueue.h)
+template <typename T, typename K = int>
+class BinaryHeap final : public PriorityQueue<T, K> {
 private:
-    vector<pair<int, T>> heap;
+    vector<pair<K, T>> heap;
     vector<int> position;  // value -> index, -1 if not in heap
     long opCount;
 
     void bubbleUp(int i) {
         while (i > 0) {
             int parent = (i - 1) / 2;
+            HEAP_STATS_COMPARE(1);
             if (heap[parent].first <= heap[i].first) break;
+            HEAP_STATS_MOVE(2);
             swap(heap[parent], heap[i]);
             position[heap[parent].second] = parent;
             position[heap[i].second] = i;
@@ -32,11 +35,13 @@ private:
             int left = 2 * i + 1;
             int right = 2 * i + 2;
             int smallest = i;
+            HEAP_STATS_COMPARE((left < n) + (right < n));
             if (left < n && heap[left].first < heap[smallest].first)
                 smallest = left;
             if (right < n && heap[right].first < heap[smallest].first)
                 smallest = right;
             if (smallest == i) break;
+            HEAP_STATS_MOVE(2);
             swap(heap[i], heap[smallest]);
             position[heap[i].second] = i;
             position[heap[smallest].second] = smallest;
@@ -49,22 +54,27 @@ public:
         position.assign(maxVertices, -1);
     }
 
-    void insert(int key, T value) override {
+    void insert(K key, T value) override {
+        HEAP_STATS_OP(HEAP_INSERT);
         int i = (int)heap.size();
+        HEAP_STATS_MOVE(1);
         heap.push_back({key, value});
         position[value] = i;
         bubbleUp(i);
         opCount++;
     }
 
-    bool extractMin(int &outKey, T &outValue) override {
+    bool extractMin(K &outKey, T &outValue) override {
         if (heap.empty()) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        HEAP_STATS_SHAPE(heapDepth(heap.size(), 2));
         outKey = heap[0].first;
         outValue = heap[0].second;
         position[outValue] = -1;
         if (heap.size() == 1) {
             heap.pop_back();
         } else {
+            HEAP_STATS_MOVE(1);
             heap[0] = heap.back();
             heap.pop_back();
             position[heap[0].second] = 0;
@@ -74,7 +84,8 @@ public:
         return true;
     }
 
-    void decreaseKey(T value, int newKey) override {
+    void decreaseKey(T value, K newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
         int i = position[value];
         if (i < 0) return;
         if (newKey >= heap[i].first) return;
@@ -0,0 +1,51 @@
+#ifndef BUCKET_LISTS_H
+#define BUCKET_LISTS_H
+
+#include <vector>
+using std::vector;
+
+// intrusive doubly linked lists of vertex ids, one list per bucket.
+// shared by the monotone integer queues (DialQueue, RadixHeap) so that
+// decreaseKey can move a vertex between buckets in O(1).
+class BucketLists {
+public:
+    BucketLists(int numBuckets, int maxVertices)
+        : head(numBuckets, -1), next(maxVertices, -1), prev(maxVertices, -1), owner(maxVertices, -1) {}
+
+    bool empty(int b) const { return head[b] < 0; }
+    int front(int b) const { return head[b]; }
+    int nextOf(int v) const { return next[v]; }
+    // bucket holding v, -1 if v is not queued
+    int bucketOf(int v) const { return owner[v]; }
+
+    void push(int b, int v) {
+        prev[v] = -1;
+        next[v] = head[b];
+        if (head[b] >= 0) prev[head[b]] = v;
+        head[b] = v;
+        owner[v] = b;
+    }
+
+    void remove(int v) {
+        int b = owner[v];
+        if (prev[v] >= 0) next[prev[v]] = next[v];
+        else head[b] = next[v];
+        if (next[v] >= 0) prev[next[v]] = prev[v];
+        owner[v] = -1;
+    }
+
+    // detach a whole bucket; returns its first vertex (walk with nextOf before re-pushing)
+    int takeAll(int b) {
+        int first = head[b];
+        head[b] = -1;
+        return first;
+    }
+
+private:
+    vector<int> head;
+    vector<int> next;
+    vector<int> prev;
+    vector<int> owner;
+};
+
+#endif
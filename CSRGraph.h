@@ -0,0 +1,205 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "Graph.h"
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+using std::vector;
+
+// contiguous edge range for one vertex (interleaved target/weight)
+struct EdgeSpan {
+    const Edge* first;
+    const Edge* last;
+    const Edge* begin() const { return first; }
+    const Edge* end() const { return last; }
+};
+
+// edge range over split target/weight arrays; yields Edge by value
+struct SplitEdgeSpan {
+    struct iterator {
+        const int* t;
+        const int* w;
+        Edge operator*() const { return {*t, *w}; }
+        iterator& operator++() { ++t; ++w; return *this; }
+        bool operator!=(const iterator& o) const { return t != o.t; }
+    };
+    iterator first;
+    iterator last;
+    iterator begin() const { return first; }
+    iterator end() const { return last; }
+};
+
+// compressed sparse row: offsets[u]..offsets[u+1] index u's edges in one allocation.
+// Split=false keeps Edge{target,weight} interleaved, Split=true uses two parallel arrays.
+template <bool Split>
+class BasicCSRGraph;
+
+template <>
+class BasicCSRGraph<false> {
+public:
+    int numVertices;
+    vector<long long> offsets;
+    vector<Edge> edges;
+
+    BasicCSRGraph() : numVertices(0), offsets(1, 0) {}
+
+    // same per-vertex edge order as the adjacency list
+    explicit BasicCSRGraph(const Graph& g) : numVertices(g.numVertices) {
+        offsets.assign((size_t)numVertices + 1, 0);
+        for (int u = 0; u < numVertices; u++)
+            offsets[u + 1] = offsets[u] + (long long)g.adjList[u].size();
+        edges.reserve((size_t)offsets[numVertices]);
+        for (int u = 0; u < numVertices; u++)
+            edges.insert(edges.end(), g.adjList[u].begin(), g.adjList[u].end());
+    }
+
+    EdgeSpan neighbors(int u) const {
+        const Edge* base = edges.data();
+        return { base + offsets[u], base + offsets[u + 1] };
+    }
+
+    long long numEdges() const { return offsets[numVertices]; }
+};
+
+template <>
+class BasicCSRGraph<true> {
+public:
+    int numVertices;
+    vector<long long> offsets;
+    vector<int> targets;
+    vector<int> weights;
+
+    BasicCSRGraph() : numVertices(0), offsets(1, 0) {}
+
+    explicit BasicCSRGraph(const Graph& g) : numVertices(g.numVertices) {
+        offsets.assign((size_t)numVertices + 1, 0);
+        for (int u = 0; u < numVertices; u++)
+            offsets[u + 1] = offsets[u] + (long long)g.adjList[u].size();
+        targets.reserve((size_t)offsets[numVertices]);
+        weights.reserve((size_t)offsets[numVertices]);
+        for (int u = 0; u < numVertices; u++) {
+            for (const Edge& e : g.adjList[u]) {
+                targets.push_back(e.target);
+                weights.push_back(e.weight);
+            }
+        }
+    }
+
+    SplitEdgeSpan neighbors(int u) const {
+        const int* t = targets.data();
+        const int* w = weights.data();
+        return { { t + offsets[u], w + offsets[u] },
+                 { t + offsets[u + 1], w + offsets[u + 1] } };
+    }
+
+    long long numEdges() const { return offsets[numVertices]; }
+};
+
+typedef BasicCSRGraph<false> CSRGraph;
+typedef BasicCSRGraph<true> SplitCSRGraph;
+
+// transpose of any CSR-like graph: every edge u->v becomes v->u, grouped by v in
+// order of u (backward searches on directed graphs)
+template <typename GraphT>
+CSRGraph reversedCSR(const GraphT& g) {
+    CSRGraph r;
+    int n = g.numVertices;
+    r.numVertices = n;
+    r.offsets.assign((size_t)n + 1, 0);
+    for (int u = 0; u < n; u++)
+        for (const auto& e : g.neighbors(u))
+            r.offsets[e.target + 1]++;
+    for (int v = 0; v < n; v++)
+        r.offsets[v + 1] += r.offsets[v];
+    r.edges.resize((size_t)r.offsets[n]);
+    vector<long long> cursor(r.offsets.begin(), r.offsets.end() - 1);
+    for (int u = 0; u < n; u++)
+        for (const auto& e : g.neighbors(u))
+            r.edges[(size_t)cursor[e.target]++] = { u, e.weight };
+    return r;
+}
+
+// true if every arc u->v (weight w) has a matching v->u (weight w), i.e. g equals its
+// reverse as a multiset of arcs per vertex: prim's tree weight only means something then
+template <typename GraphT>
+bool isSymmetric(const GraphT& g, const CSRGraph& reverse) {
+    vector<std::pair<int, int>> out, in;
+    for (int u = 0; u < g.numVertices; u++) {
+        out.clear();
+        in.clear();
+        for (const auto& e : g.neighbors(u)) out.push_back({ e.target, e.weight });
+        for (const auto& e : reverse.neighbors(u)) in.push_back({ e.target, e.weight });
+        if (out.size() != in.size()) return false;
+        std::sort(out.begin(), out.end());
+        std::sort(in.begin(), in.end());
+        if (out != in) return false;
+    }
+    return true;
+}
+
+// collects edges with the Graph interface (numVertices, addEdge, addUndirectedEdge)
+// so the generators can fill it directly, then builds CSR with a counting pass.
+// per-vertex edge order matches what the same calls would produce on a Graph.
+class CSRBuilder {
+public:
+    int numVertices;
+
+    explicit CSRBuilder(int n) : numVertices(n), degree(n, 0) {}
+
+    void addEdge(int u, int v, int weight) {
+        sources.push_back(u);
+        out.push_back({v, weight});
+        degree[u]++;
+    }
+
+    void addUndirectedEdge(int u, int v, int weight) {
+        addEdge(u, v, weight);
+        addEdge(v, u, weight);
+    }
+
+    void reserve(size_t numDirectedEdges) {
+        sources.reserve(numDirectedEdges);
+        out.reserve(numDirectedEdges);
+    }
+
+    CSRGraph build() const {
+        CSRGraph g;
+        fillOffsets(g.offsets);
+        g.numVertices = numVertices;
+        g.edges.resize(out.size());
+        vector<long long> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (size_t i = 0; i < out.size(); i++)
+            g.edges[(size_t)cursor[sources[i]]++] = out[i];
+        return g;
+    }
+
+    SplitCSRGraph buildSplit() const {
+        SplitCSRGraph g;
+        fillOffsets(g.offsets);
+        g.numVertices = numVertices;
+        g.targets.resize(out.size());
+        g.weights.resize(out.size());
+        vector<long long> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (size_t i = 0; i < out.size(); i++) {
+            size_t slot = (size_t)cursor[sources[i]]++;
+            g.targets[slot] = out[i].target;
+            g.weights[slot] = out[i].weight;
+        }
+        return g;
+    }
+
+private:
+    vector<int> degree;
+    vector<int> sources;
+    vector<Edge> out;
+
+    void fillOffsets(vector<long long>& offsets) const {
+        offsets.assign((size_t)numVertices + 1, 0);
+        for (int u = 0; u < numVertices; u++)
+            offsets[u + 1] = offsets[u] + degree[u];
+    }
+};
+
+#endif
@@ -0,0 +1,277 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include "Algorithms.h"
+#include "BinaryHeap.h"
+#include "CSRGraph.h"
+#include "QueryWorkspace.h"
+#include <vector>
+#include <algorithm>
+using std::vector;
+
+// contraction hierarchies for repeated s-t queries on one fixed graph (directed or
+// not). preprocessing contracts the vertices one by one in order of importance:
+// removing v, every path u -> v -> x that is the only shortest u-x path gets a
+// shortcut u -> x of the same length (a bounded witness search looks for another).
+// every edge and shortcut then points up (to the later contracted end) in exactly
+// one of two CSR graphs, and a query is a bidirectional dijkstra that only goes up
+// from both ends; the two searches meet at the highest vertex of a shortest path.
+// contraction stops early if the remaining graph gets dense (random graphs do, road
+// networks and grids only at the very top): the rest is an uncontracted core whose
+// arcs go into both search graphs, so a query runs plain bidirectional dijkstra
+// inside it. query answers distances (shortcuts are not unpacked into paths).
+class ContractionHierarchy {
+public:
+    int numVertices;
+    long long numShortcuts;
+    int coreSize;      // vertices left uncontracted, ranked last
+    vector<int> rank;  // contraction order: rank[v] = number of vertices contracted before v
+    CSRGraph up;       // at u: arcs u -> x with rank[x] > rank[u], or both in the core (forward search)
+    CSRGraph down;     // at u: arcs x -> u likewise, stored as (x, w) (backward search)
+
+    // contracts all of g; witness searches run on the caller's workspace (any heap,
+    // sized g.numVertices). order: lowest edge difference first (shortcuts added
+    // minus arcs removed) plus the number of contracted neighbours, which spreads
+    // contraction evenly over the graph. priorities are updated lazily: recomputed
+    // when a vertex comes out of the queue, which also yields its shortcuts (updating
+    // the neighbours after every contraction as well costs ~4x the time on grids for
+    // no better hierarchy).
+    template <typename GraphT, typename HeapT>
+    ContractionHierarchy(const GraphT& g, QueryWorkspace<HeapT>& witness)
+        : numVertices(g.numVertices), numShortcuts(0), coreSize(0), rank(g.numVertices, -1) {
+        static_assert(IsPriorityQueue<HeapT, int>::value,
+                      "ContractionHierarchy: heap needs insert(int, T), extractMin(int&, T&), decreaseKey(T, int), "
+                      "isEmpty()");
+        int n = numVertices;
+        Contraction c(n);
+        for (int u = 0; u < n; u++)
+            for (const auto& e : g.neighbors(u))
+                if (e.target != u) c.addArc(u, e.target, e.weight);
+
+        BinaryHeap<int> order(n);
+        vector<WeightedEdge> shortcuts;
+        for (int v = 0; v < n; v++)
+            order.insert(c.priority(v, witness, shortcuts), v);
+        int next = 0;
+        while (!order.isEmpty() && c.numArcs <= CORE_DEGREE * (long long)(n - next)) {
+            int k, v;
+            order.extractMin(k, v);
+            int p = c.priority(v, witness, shortcuts);
+            if (p > k) {  // got worse since queued: back in line
+                order.insert(p, v);
+                continue;
+            }
+            rank[v] = next++;
+            for (const WeightedEdge& s : shortcuts)
+                if (c.addArc(s.u, s.v, s.weight)) numShortcuts++;
+            c.remove(v);
+        }
+        while (!order.isEmpty()) {
+            int k, v;
+            order.extractMin(k, v);
+            rank[v] = next++;
+            coreSize++;
+            c.up.adjList[v] = c.out[v];
+            c.down.adjList[v] = c.in[v];
+        }
+        up = CSRGraph(c.up);
+        down = CSRGraph(c.down);
+    }
+
+    size_t searchGraphBytes() const {
+        return (up.offsets.size() + down.offsets.size()) * sizeof(long long) +
+               (up.edges.size() + down.edges.size()) * sizeof(Edge);
+    }
+
+    // dist(source, target), INF if unreachable: forward search on up, backward on
+    // down, one settle each in turn. a side stops once it extracts a key >= mu (the
+    // best meeting seen so far); a vertex that the other side of its own search
+    // graph reaches more cheaply from above is stalled (settled, not expanded), as
+    // it cannot be on a shortest up-down path. settled counts stay in the workspaces.
+    template <typename HeapT>
+    int query(int source, int target, QueryWorkspace<HeapT>& fwd, QueryWorkspace<HeapT>& bwd) const {
+        static_assert(IsPriorityQueue<HeapT, int>::value,
+                      "ContractionHierarchy::query: heap needs insert(int, T), extractMin(int&, T&), "
+                      "decreaseKey(T, int), isEmpty()");
+        fwd.begin();
+        bwd.begin();
+        fwd.setDist(source, 0, -1);
+        fwd.heap.insert(0, source);
+        fwd.markQueued(source);
+        bwd.setDist(target, 0, -1);
+        bwd.heap.insert(0, target);
+        bwd.markQueued(target);
+        int mu = source == target ? 0 : INF;
+
+        bool doneF = false, doneB = false, forward = true;
+        while (true) {
+            doneF = doneF || fwd.heap.isEmpty();
+            doneB = doneB || bwd.heap.isEmpty();
+            if (doneF && doneB) break;
+            if (doneF) forward = false;
+            else if (doneB) forward = true;
+            QueryWorkspace<HeapT>& ws = forward ? fwd : bwd;
+            int d, u;
+            ws.heap.extractMin(d, u);
+            if (!ws.settled(u)) {
+                if (d >= mu) {
+                    (forward ? doneF : doneB) = true;
+                } else {
+                    ws.markSettled(u);
+                    if (forward && !stalled(down, u, d, fwd)) relax(up, u, d, fwd, bwd, mu);
+                    if (!forward && !stalled(up, u, d, bwd)) relax(down, u, d, bwd, fwd, mu);
+                }
+            }
+            forward = !forward;
+        }
+        return mu;
+    }
+
+private:
+    // witness searches give up after settling this many vertices (a missed witness
+    // only costs an unneeded shortcut)
+    static const int WITNESS_SETTLE_LIMIT = 100;
+
+    // contraction stops once the remaining graph averages more arcs per vertex
+    static const int CORE_DEGREE = 16;
+
+    // the graph still being contracted, and the arcs of the contracted vertices
+    struct Contraction {
+        vector<vector<Edge>> out;  // arcs among uncontracted vertices
+        vector<vector<Edge>> in;   // same arcs at their heads, (tail, w)
+        long long numArcs;
+        vector<int> contractedNeighbours;
+        vector<char> isTarget;     // out-neighbours of the vertex whose shortcuts are being found
+        vector<int> neighbours;
+        Graph up;
+        Graph down;
+
+        explicit Contraction(int n) : out(n), in(n), numArcs(0), contractedNeighbours(n, 0), isTarget(n, 0), up(n), down(n) {}
+
+        // u -> x, keeping the lighter of parallel arcs; false if an existing arc was as short
+        bool addArc(int u, int x, int w) {
+            for (Edge& e : out[u]) {
+                if (e.target != x) continue;
+                if (e.weight <= w) return false;
+                e.weight = w;
+                for (Edge& r : in[x])
+                    if (r.target == u) r.weight = w;
+                return true;
+            }
+            out[u].push_back({ x, w });
+            in[x].push_back({ u, w });
+            numArcs++;
+            return true;
+        }
+
+        // contracts v (its shortcuts already added): its arcs become up/down arcs
+        void remove(int v) {
+            neighbours.clear();
+            for (const Edge& e : out[v]) {
+                eraseArc(in[e.target], v);
+                neighbours.push_back(e.target);
+            }
+            for (const Edge& e : in[v]) {
+                eraseArc(out[e.target], v);
+                neighbours.push_back(e.target);
+            }
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (int w : neighbours) contractedNeighbours[w]++;
+            numArcs -= (long long)(out[v].size() + in[v].size());
+            up.adjList[v].swap(out[v]);
+            down.adjList[v].swap(in[v]);
+        }
+
+        // edge difference + contracted neighbours; shortcuts receives what contracting v would add
+        template <typename HeapT>
+        int priority(int v, QueryWorkspace<HeapT>& ws, vector<WeightedEdge>& shortcuts) {
+            findShortcuts(v, ws, shortcuts);
+            return (int)shortcuts.size() - (int)(in[v].size() + out[v].size()) + contractedNeighbours[v];
+        }
+
+        // u -> v -> x paths with no witness of at most the same length
+        template <typename HeapT>
+        void findShortcuts(int v, QueryWorkspace<HeapT>& ws, vector<WeightedEdge>& shortcuts) {
+            shortcuts.clear();
+            int maxOut = 0;
+            for (const Edge& e : out[v]) {
+                maxOut = std::max(maxOut, e.weight);
+                isTarget[e.target] = 1;
+            }
+            for (const Edge& a : in[v]) {
+                int u = a.target;
+                witnessSearch(u, v, a.weight + maxOut, (int)out[v].size(), ws);
+                for (const Edge& b : out[v]) {
+                    int via = a.weight + b.weight;
+                    if (b.target != u && ws.dist(b.target) > via) shortcuts.push_back({ u, b.target, via });
+                }
+            }
+            for (const Edge& e : out[v]) isTarget[e.target] = 0;
+        }
+
+        // dijkstra from u avoiding v, until keys pass limit, the out-neighbours of v
+        // (numTargets, counting a target u too) are settled or the settle limit is hit;
+        // ws.dist(x) is then the length of some u-x path without v (or unreached)
+        template <typename HeapT>
+        void witnessSearch(int u, int v, int limit, int numTargets, QueryWorkspace<HeapT>& ws) const {
+            HeapT& pq = ws.heap;
+            ws.begin();
+            ws.setDist(u, 0, -1);
+            pq.insert(0, u);
+            ws.markQueued(u);
+            while (!pq.isEmpty()) {
+                int d, w;
+                pq.extractMin(d, w);
+                if (ws.settled(w)) continue;
+                if (d > limit || ws.settledCount() >= WITNESS_SETTLE_LIMIT) return;
+                ws.markSettled(w);
+                if (isTarget[w] && --numTargets == 0) return;
+                for (const Edge& e : out[w]) {
+                    int x = e.target;
+                    int newDist = d + e.weight;
+                    if (x == v || ws.settled(x) || newDist >= ws.dist(x)) continue;
+                    ws.setDist(x, newDist, w);
+                    if (ws.queued(x))
+                        pq.decreaseKey(x, newDist);
+                    else {
+                        pq.insert(newDist, x);
+                        ws.markQueued(x);
+                    }
+                }
+            }
+        }
+    };
+
+    // stall on demand: u is reached more cheaply through an arc from a higher vertex
+    template <typename HeapT>
+    static bool stalled(const CSRGraph& from, int u, int d, const QueryWorkspace<HeapT>& ws) {
+        for (const Edge& e : from.neighbors(u)) {
+            int dx = ws.dist(e.target);
+            if (dx != INF && (long long)dx + e.weight < d) return true;
+        }
+        return false;
+    }
+
+    // one side's upward edge scan; reaching a vertex the other side has reached lowers mu
+    template <typename HeapT>
+    static void relax(const CSRGraph& g, int u, int d, QueryWorkspace<HeapT>& ws, const QueryWorkspace<HeapT>& other,
+                      int& mu) {
+        for (const Edge& e : g.neighbors(u)) {
+            int v = e.target;
+            int newDist = d + e.weight;
+            if (ws.settled(v) || newDist >= ws.dist(v)) continue;
+            ws.setDist(v, newDist, u);
+            if (ws.queued(v))
+                ws.heap.decreaseKey(v, newDist);
+            else {
+                ws.heap.insert(newDist, v);
+                ws.markQueued(v);
+            }
+            int rest = other.dist(v);
+            if (rest != INF && (long long)newDist + rest < mu) mu = newDist + rest;
+        }
+    }
+};
+
+#endif
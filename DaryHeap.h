@@ -0,0 +1,189 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include "PriorityQueue.h"
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+using std::vector;
+
+// d-ary min-heap, arity fixed at compile time.
+// keys and values live in separate arrays; keys[1] is 64-byte aligned, so the
+// children of i (D*i+1 .. D*i+D) start on a D-key boundary and for D=16 (int keys)
+// each child group is exactly one cache line.
+// slots past the end hold the largest key, so the min-child search always scans a
+// whole group and never needs a bounds mask (with SIMD for int keys; other key
+// types, e.g. long long distances, take the scalar loop).
+template <typename T, int D, typename K = int>
+class DaryHeap final : public PriorityQueue<T, K> {
+    static_assert(D >= 2 && D <= 16, "DaryHeap arity must be 2..16");
+
+private:
+    static constexpr K KEY_MAX = std::numeric_limits<K>::max();
+    static constexpr bool SIMD_KEYS = std::is_same<K, int>::value && D % 4 == 0;
+
+    vector<K> keyStore;  // backing storage, over-allocated for alignment
+    K* keys;             // logical index i -> keys[i]
+    vector<T> values;
+    vector<int> position;  // value -> index, -1 if not in heap
+    int size;
+    long opCount;
+
+    // index (0..D-1) of the smallest key in one aligned child group; ties -> lowest index
+    static int minChild(const K* group) {
+#if defined(__SSE2__)
+        if constexpr (SIMD_KEYS) {
+            __m128i m = _mm_load_si128((const __m128i*)group);
+            for (int j = 4; j < D; j += 4)
+                m = min4(m, _mm_load_si128((const __m128i*)(group + j)));
+            m = min4(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+            m = min4(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+            for (int j = 0; j < D; j += 4) {
+                __m128i eq = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(group + j)), m);
+                int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+                if (mask) return j + lowBit(mask);
+            }
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        if constexpr (SIMD_KEYS) {
+            int32x4_t m = vld1q_s32(group);
+            for (int j = 4; j < D; j += 4)
+                m = vminq_s32(m, vld1q_s32(group + j));
+            int best = vminvq_s32(m);
+            for (int j = 0; j < D; j++)
+                if (group[j] == best) return j;
+        }
+#endif
+        int best = 0;
+        for (int j = 1; j < D; j++)
+            if (group[j] < group[best]) best = j;
+        return best;
+    }
+
+#if defined(__SSE2__)
+    static __m128i min4(__m128i a, __m128i b) {
+#if defined(__SSE4_1__)
+        return _mm_min_epi32(a, b);
+#else
+        __m128i lt = _mm_cmplt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(lt, a), _mm_andnot_si128(lt, b));
+#endif
+    }
+
+    static int lowBit(int mask) {
+        int b = 0;
+        while (!(mask & 1)) { mask >>= 1; b++; }
+        return b;
+    }
+#endif
+
+    void place(int i, K key, T value) {
+        HEAP_STATS_MOVE(1);
+        keys[i] = key;
+        values[i] = value;
+        position[value] = i;
+    }
+
+    void bubbleUp(int i) {
+        K key = keys[i];
+        T value = values[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            HEAP_STATS_COMPARE(1);
+            if (keys[parent] <= key) break;
+            place(i, keys[parent], values[parent]);
+            i = parent;
+        }
+        place(i, key, value);
+    }
+
+    void bubbleDown(int i) {
+        K key = keys[i];
+        T value = values[i];
+        while (true) {
+            int first = D * i + 1;
+            if (first >= size) break;
+            // d-1 for the min child (whole padded group), 1 against key
+            HEAP_STATS_COMPARE(D);
+            int c = first + minChild(keys + first);
+            if (keys[c] >= key) break;
+            place(i, keys[c], values[c]);
+            i = c;
+        }
+        place(i, key, value);
+    }
+
+public:
+    explicit DaryHeap(int maxVertices) : size(0), opCount(0) {
+        // maxVertices + one padding group + 64 bytes of alignment slack
+        keyStore.assign((size_t)maxVertices + D + 64 / sizeof(K), KEY_MAX);
+        uintptr_t base = (uintptr_t)(keyStore.data() + 1);
+        uintptr_t aligned = (base + 63) & ~(uintptr_t)63;
+        keys = (K*)aligned - 1;
+        values.resize(maxVertices);
+        position.assign(maxVertices, -1);
+    }
+
+    // keys points into keyStore
+    DaryHeap(const DaryHeap&) = delete;
+    DaryHeap& operator=(const DaryHeap&) = delete;
+
+    void insert(K key, T value) override {
+        HEAP_STATS_OP(HEAP_INSERT);
+        int i = size++;
+        keys[i] = key;
+        values[i] = value;
+        position[value] = i;
+        bubbleUp(i);
+        opCount++;
+    }
+
+    bool extractMin(K &outKey, T &outValue) override {
+        if (size == 0) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        HEAP_STATS_SHAPE(heapDepth(size, D));
+        outKey = keys[0];
+        outValue = values[0];
+        position[outValue] = -1;
+        size--;
+        if (size > 0) {
+            keys[0] = keys[size];
+            values[0] = values[size];
+            keys[size] = KEY_MAX;
+            bubbleDown(0);
+        } else {
+            keys[0] = KEY_MAX;
+        }
+        opCount++;
+        return true;
+    }
+
+    void decreaseKey(T value, K newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
+        int i = position[value];
+        if (i < 0) return;
+        if (newKey >= keys[i]) return;
+        keys[i] = newKey;
+        bubbleUp(i);
+        opCount++;
+    }
+
+    bool isEmpty() const override { return size == 0; }
+    long getOperationCount() const override { return opCount; }
+};
+
+// single-parameter names for the benchmark's heap table
+template <typename T> using DaryHeap4 = DaryHeap<T, 4>;
+template <typename T> using DaryHeap8 = DaryHeap<T, 8>;
+template <typename T> using DaryHeap16 = DaryHeap<T, 16>;
+
+#endif
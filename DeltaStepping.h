@@ -0,0 +1,118 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include "Algorithms.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <atomic>
+#include <memory>
+using std::vector;
+
+// parallel delta-stepping sssp (meyer & sanders), same dist as runDijkstra.
+// vertices sit in buckets of width delta by tentative distance. the lowest
+// non-empty bucket is drained by repeated parallel light-edge (w <= delta)
+// relaxation until it stays empty, then the heavy edges of everything settled
+// in it are relaxed once. dist updates use an atomic min; improved vertices are
+// collected per worker and bucketed between phases (stale entries are skipped).
+class DeltaStepping {
+public:
+    template <typename GraphT>
+    static void run(const GraphT& g, int source, int delta, int numThreads, vector<int>& dist) {
+        ThreadPool pool(numThreads);
+        run(g, source, delta, pool, dist);
+    }
+
+    template <typename GraphT>
+    static void run(const GraphT& g, int source, int delta, ThreadPool& pool, vector<int>& dist) {
+        const int CHUNK = 256;
+        int n = g.numVertices;
+        if (delta < 1) delta = 1;
+
+        std::unique_ptr<std::atomic<int>[]> d(new std::atomic<int>[n]);
+        for (int v = 0; v < n; v++) d[v].store(INF, std::memory_order_relaxed);
+        d[source].store(0, std::memory_order_relaxed);
+
+        vector<vector<int>> buckets(1);
+        buckets[0].push_back(source);
+        vector<vector<int>> updated(pool.size());
+        vector<int> frontierStamp(n, -1);  // dedupe within one light phase
+        vector<int> settledStamp(n, -1);   // dedupe within one bucket
+        vector<int> frontier, settled;
+        int phase = 0;
+
+        // relax u's edges with light (w <= delta) or heavy weights; improvements go to updated[worker]
+        auto relax = [&](int worker, int u, bool light) {
+            int du = d[u].load(std::memory_order_relaxed);
+            for (const auto& edge : g.neighbors(u)) {
+                if ((edge.weight <= delta) != light) continue;
+                int nd = du + edge.weight;
+                if (atomicMin(d[edge.target], nd))
+                    updated[worker].push_back(edge.target);
+            }
+        };
+
+        auto bucketUpdates = [&]() {
+            for (vector<int>& list : updated) {
+                for (int v : list) {
+                    size_t b = (size_t)(d[v].load(std::memory_order_relaxed) / delta);
+                    if (b >= buckets.size()) buckets.resize(b + 1);
+                    buckets[b].push_back(v);
+                }
+                list.clear();
+            }
+        };
+
+        for (size_t i = 0; i < buckets.size(); i++) {
+            settled.clear();
+            while (!buckets[i].empty()) {
+                // take live, distinct entries of bucket i as this phase's frontier
+                frontier.clear();
+                for (int v : buckets[i]) {
+                    if ((size_t)(d[v].load(std::memory_order_relaxed) / delta) != i) continue;
+                    if (frontierStamp[v] == phase) continue;
+                    frontierStamp[v] = phase;
+                    frontier.push_back(v);
+                    if (settledStamp[v] != (int)i) {
+                        settledStamp[v] = (int)i;
+                        settled.push_back(v);
+                    }
+                }
+                buckets[i].clear();
+                phase++;
+
+                int chunks = ((int)frontier.size() + CHUNK - 1) / CHUNK;
+                pool.parallelFor(chunks, [&](int worker, int c) {
+                    int end = std::min((int)frontier.size(), (c + 1) * CHUNK);
+                    for (int k = c * CHUNK; k < end; k++)
+                        relax(worker, frontier[k], true);
+                });
+                bucketUpdates();
+            }
+
+            int chunks = ((int)settled.size() + CHUNK - 1) / CHUNK;
+            pool.parallelFor(chunks, [&](int worker, int c) {
+                int end = std::min((int)settled.size(), (c + 1) * CHUNK);
+                for (int k = c * CHUNK; k < end; k++)
+                    relax(worker, settled[k], false);
+            });
+            bucketUpdates();
+        }
+
+        dist.resize(n);
+        for (int v = 0; v < n; v++)
+            dist[v] = d[v].load(std::memory_order_relaxed);
+    }
+
+private:
+    // lower a to v if smaller; true if this call did it
+    static bool atomicMin(std::atomic<int>& a, int v) {
+        int cur = a.load(std::memory_order_relaxed);
+        while (v < cur) {
+            if (a.compare_exchange_weak(cur, v, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef DIAL_QUEUE_H
+#define DIAL_QUEUE_H
+
+#include "PriorityQueue.h"
+#include "BucketLists.h"
+#include <vector>
+#include <stdexcept>
+using std::vector;
+
+// dial's bucket queue: maxEdgeWeight+1 circular buckets indexed by key.
+// only valid for monotone use (dijkstra with edge weights in 0..maxEdgeWeight):
+// every queued key must lie in [cur, cur + maxEdgeWeight] where cur is the last
+// extracted key. prim's keys are not monotone, so it throws std::logic_error.
+template <typename T>
+class DialQueue final : public PriorityQueue<T> {
+private:
+    int numBuckets;
+    BucketLists buckets;
+    vector<int> keyOf;  // value -> key while queued
+    int cur;            // last extracted key (lower bound of the window)
+    int count;
+    long opCount;
+
+    void checkWindow(int key) const {
+        if (key < cur)
+            throw std::logic_error("DialQueue: key below last extracted key (needs monotone keys, not usable for Prim)");
+        if (key - cur >= numBuckets)
+            throw std::logic_error("DialQueue: key exceeds last extracted key + maxEdgeWeight");
+    }
+
+public:
+    explicit DialQueue(int maxVertices, int maxEdgeWeight = 100)
+        : numBuckets(maxEdgeWeight + 1), buckets(maxEdgeWeight + 1, maxVertices),
+          keyOf(maxVertices, 0), cur(0), count(0), opCount(0) {}
+
+    void insert(int key, T value) override {
+        HEAP_STATS_OP(HEAP_INSERT);
+        checkWindow(key);
+        HEAP_STATS_MOVE(1);
+        keyOf[value] = key;
+        buckets.push(key % numBuckets, value);
+        count++;
+        opCount++;
+    }
+
+    bool extractMin(int &outKey, T &outValue) override {
+        if (count == 0) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        int start = cur;
+        while (buckets.empty(cur % numBuckets)) cur++;
+        HEAP_STATS_COMPARE(cur - start + 1);
+        HEAP_STATS_SHAPE(cur - start + 1);
+        int v = buckets.front(cur % numBuckets);
+        buckets.remove(v);
+        outKey = cur;
+        outValue = v;
+        count--;
+        opCount++;
+        return true;
+    }
+
+    void decreaseKey(T value, int newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
+        if (buckets.bucketOf(value) < 0) return;
+        HEAP_STATS_COMPARE(1);
+        if (newKey >= keyOf[value]) return;
+        checkWindow(newKey);
+        HEAP_STATS_MOVE(1);
+        buckets.remove(value);
+        keyOf[value] = newKey;
+        buckets.push(newKey % numBuckets, value);
+        opCount++;
+    }
+
+    bool isEmpty() const override { return count == 0; }
+
+    // rewind the monotone lower bound so an emptied queue can serve another query
+    void reset() { cur = 0; }
+    long getOperationCount() const override { return opCount; }
+};
+
+#endif
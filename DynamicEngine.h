@@ -0,0 +1,391 @@
+#ifndef DYNAMIC_ENGINE_H
+#define DYNAMIC_ENGINE_H
+
+#include "Algorithms.h"
+#include "DynamicGraph.h"
+#include "UnionFind.h"
+#include <vector>
+#include <memory>
+#include <algorithm>
+using std::vector;
+
+// shortest-path tree from one source, kept up to date under edge changes instead of
+// rerunning dijkstra. HeapT is the concrete heap, built once as HeapT(n); it must
+// take keys in any order (not a monotone queue: repairs seed it with arbitrary keys).
+template <typename HeapT>
+class DynamicSSSP {
+public:
+    DynamicSSSP(const DynamicGraph& graph, int source)
+        : g(graph), src(source), heap(graph.numVertices), dist(graph.numVertices, INF),
+          parent(graph.numVertices, -1), inHeap(graph.numVertices, 0), inSubtree(graph.numVertices, 0) {
+        static_assert(IsPriorityQueue<HeapT, int>::value,
+                      "DynamicSSSP: heap needs insert(int, T), extractMin(int&, T&), decreaseKey(T, int), isEmpty()");
+        dist[src] = 0;
+        push(src);
+        propagate();
+    }
+
+    DynamicSSSP(const DynamicSSSP&) = delete;
+    DynamicSSSP& operator=(const DynamicSSSP&) = delete;
+
+    int source() const { return src; }
+    const vector<int>& distances() const { return dist; }
+    int parentOf(int v) const { return parent[v]; }  // -1: source or unreachable
+
+    // brings the tree up to date with changes already applied to the graph (one batch,
+    // in order; an edge may change several times). returns the vertices settled again.
+    //  - heavier or deleted tree arcs (ramalingam-reps): the subtrees below them lose
+    //    their distances; each subtree vertex restarts from its best in-arc from outside
+    //    the subtrees
+    //  - lighter or new arcs: relaxed with the weight the graph has now
+    // then one dijkstra-ordered propagation from every vertex whose label dropped. labels
+    // outside the subtrees stay valid path lengths throughout, so the result is exact.
+    int repair(const vector<EdgeChange>& changes) {
+        subtree.clear();
+        for (const EdgeChange& c : changes) {
+            if (!c.heavier()) continue;
+            cut(c.u, c.v);
+            if (g.undirected) cut(c.v, c.u);
+        }
+        for (size_t i = 0; i < subtree.size(); i++) {
+            int x = subtree[i];
+            for (const Edge& e : g.neighbors(x))
+                if (parent[e.target] == x) cut(x, e.target);
+        }
+        for (int v : subtree) {
+            dist[v] = INF;
+            parent[v] = -1;
+        }
+        for (int v : subtree) {
+            for (const Edge& e : g.inNeighbors(v)) {
+                int p = e.target;
+                if (!inSubtree[p] && dist[p] != INF && dist[p] + e.weight < dist[v]) {
+                    dist[v] = dist[p] + e.weight;
+                    parent[v] = p;
+                }
+            }
+            if (dist[v] != INF) push(v);
+        }
+        for (int v : subtree) inSubtree[v] = 0;
+
+        for (const EdgeChange& c : changes) {
+            if (!c.lighter()) continue;
+            relax(c.u, c.v);
+            if (g.undirected) relax(c.v, c.u);
+        }
+        return propagate();
+    }
+
+private:
+    const DynamicGraph& g;
+    int src;
+    HeapT heap;
+    vector<int> dist;
+    vector<int> parent;
+    vector<char> inHeap;
+    vector<char> inSubtree;
+    vector<int> subtree;
+
+    // v hangs off u in the tree: v (and later its subtree) must be recomputed
+    void cut(int u, int v) {
+        if (parent[v] != u || inSubtree[v]) return;
+        inSubtree[v] = 1;
+        subtree.push_back(v);
+    }
+
+    void relax(int u, int v) {
+        int w = g.weight(u, v);
+        if (w == EdgeChange::ABSENT || dist[u] == INF || dist[u] + w >= dist[v]) return;
+        dist[v] = dist[u] + w;
+        parent[v] = u;
+        push(v);
+    }
+
+    void push(int v) {
+        if (inHeap[v])
+            heap.decreaseKey(v, dist[v]);
+        else {
+            heap.insert(dist[v], v);
+            inHeap[v] = 1;
+        }
+    }
+
+    int propagate() {
+        int settled = 0;
+        while (!heap.isEmpty()) {
+            int d, u;
+            heap.extractMin(d, u);
+            inHeap[u] = 0;
+            settled++;
+            for (const Edge& e : g.neighbors(u)) {
+                int v = e.target;
+                if (d + e.weight < dist[v]) {
+                    dist[v] = d + e.weight;
+                    parent[v] = u;
+                    push(v);
+                }
+            }
+        }
+        return settled;
+    }
+};
+
+// minimum spanning forest of an undirected DynamicGraph, repaired after every single
+// edge change (the graph must be in the state right after that change):
+//  - tree edge lighter: still optimal
+//  - tree edge heavier or deleted: the tree splits; the lightest edge from the smaller
+//    side (found by growing both sides in turn) to the other rejoins it, if any
+//  - non-tree edge lighter or new: it closes a cycle with the tree path between its
+//    ends and replaces the path's heaviest edge if lighter (joins two trees if no path)
+//  - non-tree edge heavier or deleted: nothing
+// the trees are rooted (parent pointers) so a path is found by climbing from both
+// ends; joining a tree at x re-roots it at x by reversing the pointers above x. a
+// repair costs time in a path or the smaller side of a split, not a full prim run.
+class DynamicMST {
+public:
+    explicit DynamicMST(const DynamicGraph& graph)
+        : g(graph), tree(graph.numVertices), parent(graph.numVertices, -1), parentWeight(graph.numVertices, 0),
+          total(0), seen(graph.numVertices, 0), stamp(0) {
+        int n = g.numVertices;
+        vector<WeightedEdge> edges;
+        for (int u = 0; u < n; u++)
+            for (const Edge& e : g.neighbors(u))
+                if (u < e.target) edges.push_back({ u, e.target, e.weight });
+        std::stable_sort(edges.begin(), edges.end(),
+                         [](const WeightedEdge& a, const WeightedEdge& b) { return a.weight < b.weight; });
+        UnionFind uf(n);
+        for (const WeightedEdge& e : edges) {
+            if (!uf.unite(e.u, e.v)) continue;
+            tree[e.u].push_back({ e.v, e.weight });
+            tree[e.v].push_back({ e.u, e.weight });
+            total += e.weight;
+        }
+        // root every tree at its lowest vertex
+        unsigned mark = nextStamps(1);
+        vector<int> queue;
+        for (int r = 0; r < n; r++) {
+            if (seen[r] == mark) continue;
+            seen[r] = mark;
+            queue.assign(1, r);
+            for (size_t i = 0; i < queue.size(); i++) {
+                int x = queue[i];
+                for (const Edge& e : tree[x]) {
+                    if (seen[e.target] == mark) continue;
+                    seen[e.target] = mark;
+                    parent[e.target] = x;
+                    parentWeight[e.target] = e.weight;
+                    queue.push_back(e.target);
+                }
+            }
+        }
+    }
+
+    DynamicMST(const DynamicMST&) = delete;
+    DynamicMST& operator=(const DynamicMST&) = delete;
+
+    long long totalWeight() const { return total; }  // whole forest
+
+    // weight of the tree containing start (what runPrim from start sums)
+    long long treeWeight(int start) const {
+        vector<char> visited(g.numVertices, 0);
+        vector<int> queue(1, start);
+        visited[start] = 1;
+        long long sum = 0;
+        for (size_t i = 0; i < queue.size(); i++) {
+            for (const Edge& e : tree[queue[i]]) {
+                if (visited[e.target]) continue;
+                visited[e.target] = 1;
+                sum += e.weight;
+                queue.push_back(e.target);
+            }
+        }
+        return sum;
+    }
+
+    const vector<Edge>& treeNeighbors(int u) const { return tree[u]; }
+
+    // returns true if the forest changed shape (an edge left or joined it)
+    bool update(const EdgeChange& c) {
+        int u = c.u, v = c.v;
+        if (parent[u] == v || parent[v] == u) {
+            int child = parent[u] == v ? u : v;
+            if (c.newWeight != EdgeChange::ABSENT && c.newWeight <= parentWeight[child]) {
+                setWeight(child, c.newWeight);
+                return false;
+            }
+            cutEdge(u, v);
+            return true;
+        }
+        if (!c.lighter()) return false;
+        // mark u's ancestors, climb from v to the first marked one
+        unsigned mark = nextStamps(1);
+        for (int x = u; x != -1; x = parent[x]) seen[x] = mark;
+        int top = v;
+        while (top != -1 && seen[top] != mark) top = parent[top];
+        if (top == -1) {  // different trees
+            link(u, v, c.newWeight);
+            return true;
+        }
+        // heaviest edge on u..top..v, as the child below it; the end on that side of
+        // the path is cut off with the child's subtree
+        int heaviest = -1, below = -1;
+        bool uBelow = false;
+        for (int x = u; x != top; x = parent[x]) {
+            if (parentWeight[x] > heaviest) {
+                heaviest = parentWeight[x];
+                below = x;
+                uBelow = true;
+            }
+        }
+        for (int x = v; x != top; x = parent[x]) {
+            if (parentWeight[x] > heaviest) {
+                heaviest = parentWeight[x];
+                below = x;
+                uBelow = false;
+            }
+        }
+        if (heaviest <= c.newWeight) return false;
+        unlink(parent[below], below);
+        if (uBelow) link(u, v, c.newWeight);
+        else link(v, u, c.newWeight);
+        return true;
+    }
+
+private:
+    const DynamicGraph& g;
+    vector<vector<Edge>> tree;
+    vector<int> parent;        // -1 at a root
+    vector<int> parentWeight;  // weight of the edge to parent
+    long long total;
+    vector<unsigned> seen;     // stamp per search; two sides of a split use stamp and stamp + 1
+    unsigned stamp;
+    vector<int> side[2];       // cutEdge: the two sides' search queues
+
+    void setWeight(int child, int w) {
+        int p = parent[child];
+        total += w - parentWeight[child];
+        parentWeight[child] = w;
+        for (Edge& e : tree[p])
+            if (e.target == child) e.weight = w;
+        for (Edge& e : tree[child])
+            if (e.target == p) e.weight = w;
+    }
+
+    // makes x the root of its tree
+    void evert(int x) {
+        int prev = -1, prevWeight = 0;
+        while (x != -1) {
+            int next = parent[x], nextWeight = parentWeight[x];
+            parent[x] = prev;
+            parentWeight[x] = prevWeight;
+            prev = x;
+            prevWeight = nextWeight;
+            x = next;
+        }
+    }
+
+    // joins u's tree (re-rooted at u) below v; u and v must be in different trees
+    void link(int u, int v, int w) {
+        evert(u);
+        parent[u] = v;
+        parentWeight[u] = w;
+        tree[u].push_back({ v, w });
+        tree[v].push_back({ u, w });
+        total += w;
+    }
+
+    void unlink(int u, int v) {
+        int child = parent[u] == v ? u : v;
+        total -= parentWeight[child];
+        parent[child] = -1;
+        eraseArc(tree[u], v);
+        eraseArc(tree[v], u);
+    }
+
+    unsigned nextStamps(unsigned count) {
+        if (stamp + count < stamp) {  // wrapped
+            std::fill(seen.begin(), seen.end(), 0);
+            stamp = 0;
+        }
+        stamp += count;
+        return stamp - count + 1;
+    }
+
+    // removes tree edge u-v and rejoins the two sides through the lightest graph edge
+    // between them (the changed edge included, at its new weight)
+    void cutEdge(int u, int v) {
+        unlink(u, v);
+        unsigned sideU = nextStamps(2), sideV = sideU + 1;
+        side[0].assign(1, u);
+        side[1].assign(1, v);
+        seen[u] = sideU;
+        seen[v] = sideV;
+        size_t head[2] = { 0, 0 };
+        while (head[0] < side[0].size() && head[1] < side[1].size()) {
+            grow(side[0], head[0], sideU);
+            grow(side[1], head[1], sideV);
+        }
+        int small = head[0] == side[0].size() ? 0 : 1;
+        unsigned smallSide = small == 0 ? sideU : sideV;
+        int bestU = -1, bestV = -1, best = INF;
+        for (int x : side[small]) {
+            for (const Edge& e : g.neighbors(x)) {
+                if (seen[e.target] != smallSide && e.weight < best) {
+                    best = e.weight;
+                    bestU = x;
+                    bestV = e.target;
+                }
+            }
+        }
+        if (bestU >= 0) link(bestU, bestV, best);
+    }
+
+    // one step of a side's breadth-first growth
+    void grow(vector<int>& queue, size_t& head, unsigned mark) {
+        int x = queue[head++];
+        for (const Edge& e : tree[x]) {
+            if (seen[e.target] == mark) continue;
+            seen[e.target] = mark;
+            queue.push_back(e.target);
+        }
+    }
+};
+
+// a graph under batches of edge updates with its shortest-path tree from one source
+// and (undirected graphs) its minimum spanning forest. the forest is repaired after
+// each update as it is applied, the path tree once per batch.
+template <typename HeapT>
+class DynamicEngine {
+public:
+    DynamicGraph graph;
+    DynamicSSSP<HeapT> sssp;
+    std::unique_ptr<DynamicMST> mst;  // null for directed graphs
+
+    template <typename GraphT>
+    DynamicEngine(const GraphT& g, bool undirected, int source)
+        : graph(g, undirected), sssp(graph, source), mst(undirected ? new DynamicMST(graph) : nullptr) {}
+
+    DynamicEngine(const DynamicEngine&) = delete;
+    DynamicEngine& operator=(const DynamicEngine&) = delete;
+
+    struct BatchStats {
+        int relabelled;   // vertices the path repair settled again
+        int treeChanges;  // updates that changed the forest's shape
+    };
+
+    BatchStats applyBatch(const vector<EdgeUpdate>& updates) {
+        BatchStats stats = { 0, 0 };
+        changes.clear();
+        for (const EdgeUpdate& update : updates) {
+            changes.push_back(graph.apply(update));
+            if (mst && mst->update(changes.back())) stats.treeChanges++;
+        }
+        stats.relabelled = sssp.repair(changes);
+        return stats;
+    }
+
+private:
+    vector<EdgeChange> changes;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef DYNAMIC_GRAPH_H
+#define DYNAMIC_GRAPH_H
+
+#include "Graph.h"
+#include <vector>
+using std::vector;
+
+// one edge update: set the weight of u -> v (inserting it if absent), or delete it
+// with weight DELETE. on an undirected graph it applies to both directions.
+struct EdgeUpdate {
+    static const int DELETE = -1;
+
+    int u;
+    int v;
+    int weight;
+};
+
+// what an update did: weights before and after, ABSENT if the edge was not there
+struct EdgeChange {
+    static const int ABSENT = -1;
+
+    int u;
+    int v;
+    int oldWeight;
+    int newWeight;
+
+    bool heavier() const { return oldWeight != ABSENT && (newWeight == ABSENT || newWeight > oldWeight); }
+    bool lighter() const { return newWeight != ABSENT && (oldWeight == ABSENT || newWeight < oldWeight); }
+};
+
+// adjacency lists that take edge updates, one arc per ordered pair (parallel edges of
+// the input collapse to the lightest, self-loops are dropped). same neighbors(u)
+// accessor as Graph, so the static algorithms run on it directly; inNeighbors(u)
+// lists the arcs into u as (tail, w). undirected: every edge stored at both ends,
+// updates keep the two copies equal, inNeighbors is neighbors.
+class DynamicGraph {
+public:
+    int numVertices;
+    bool undirected;
+
+    template <typename GraphT>
+    DynamicGraph(const GraphT& g, bool isUndirected)
+        : numVertices(g.numVertices), undirected(isUndirected), out(g.numVertices),
+          in(isUndirected ? 0 : g.numVertices) {
+        for (int u = 0; u < numVertices; u++) {
+            for (const auto& e : g.neighbors(u)) {
+                int w = weight(u, e.target);
+                if (e.target != u && (w == EdgeChange::ABSENT || e.weight < w)) setArc(u, e.target, e.weight);
+            }
+        }
+    }
+
+    const vector<Edge>& neighbors(int u) const { return out[u]; }
+    const vector<Edge>& inNeighbors(int u) const { return undirected ? out[u] : in[u]; }
+
+    // weight of u -> v, EdgeChange::ABSENT if there is no such edge
+    int weight(int u, int v) const {
+        for (const Edge& e : out[u])
+            if (e.target == v) return e.weight;
+        return EdgeChange::ABSENT;
+    }
+
+    // self-loops are ignored (old and new weight ABSENT)
+    EdgeChange apply(const EdgeUpdate& update) {
+        int u = update.u, v = update.v;
+        if (u == v) return { u, v, EdgeChange::ABSENT, EdgeChange::ABSENT };
+        EdgeChange change = { u, v, weight(u, v), EdgeChange::ABSENT };
+        if (update.weight == EdgeUpdate::DELETE) {
+            if (change.oldWeight != EdgeChange::ABSENT) removeArc(u, v);
+        } else {
+            setArc(u, v, update.weight);
+            change.newWeight = update.weight;
+        }
+        return change;
+    }
+
+private:
+    vector<vector<Edge>> out;
+    vector<vector<Edge>> in;  // directed only
+
+    void setArc(int u, int v, int w) {
+        set(out[u], v, w);
+        if (undirected) set(out[v], u, w);
+        else set(in[v], u, w);
+    }
+
+    void removeArc(int u, int v) {
+        eraseArc(out[u], v);
+        if (undirected) eraseArc(out[v], u);
+        else eraseArc(in[v], u);
+    }
+
+    static void set(vector<Edge>& arcs, int target, int w) {
+        for (Edge& e : arcs) {
+            if (e.target == target) {
+                e.weight = w;
+                return;
+            }
+        }
+        arcs.push_back({ target, w });
+    }
+};
+
+#endif
@@ -2,134 +2,156 @@
 #define FIBONACCI_HEAP_H
 
 #include "PriorityQueue.h"
-#include <cmath>
+#include "NodePool.h"
 #include <vector>
+#include <utility>
 using std::vector;
-using std::log2;
 using std::swap;
 
 template <typename T>
-class FibonacciHeap : public PriorityQueue<T> {
+class FibonacciHeap final : public PriorityQueue<T> {
 private:
+    // links are pool indices (NIL_NODE = none)
     struct Node {
         int key;
         T value;
         int degree;
         bool marked;
-        Node* parent;
-        Node* child;
-        Node* left;
-        Node* right;
-        Node(int k, T v) : key(k), value(v), degree(0), marked(false),
-                           parent(nullptr), child(nullptr), left(this), right(this) {}
+        NodeId parent;
+        NodeId child;
+        NodeId left;
+        NodeId right;
     };
 
-    Node* minNode;
+    NodePool<Node> pool;
+    NodeId minNode;
     int n;
-    vector<Node*> nodeMapping;
+    vector<NodeId> nodeMapping;
+    vector<NodeId> degreeTable;  // consolidate scratch, all NIL between calls
     long opCount;
+    long linkCount;     // link() calls (tree merges in consolidate)
+    long cutCount;      // cut() calls, including cascading cuts
+    long extractCount;
 
-    void addToRootList(Node* node) {
-        if (!minNode) {
-            minNode = node;
-            node->left = node->right = node;
-            node->parent = nullptr;
+    void addToRootList(NodeId x) {
+        Node& node = pool[x];
+        node.parent = NIL_NODE;
+        if (minNode == NIL_NODE) {
+            minNode = x;
+            node.left = node.right = x;
             return;
         }
-        node->left = minNode;
-        node->right = minNode->right;
-        minNode->right->left = node;
-        minNode->right = node;
-        node->parent = nullptr;
+        Node& m = pool[minNode];
+        node.left = minNode;
+        node.right = m.right;
+        pool[m.right].left = x;
+        m.right = x;
     }
 
-    void removeFromList(Node* node) {
-        node->left->right = node->right;
-        node->right->left = node->left;
+    void removeFromList(NodeId x) {
+        Node& node = pool[x];
+        pool[node.left].right = node.right;
+        pool[node.right].left = node.left;
     }
 
-    void link(Node* y, Node* x) {
-        removeFromList(y);
-        if (x->child) {
-            y->left = x->child;
-            y->right = x->child->right;
-            x->child->right->left = y;
-            x->child->right = y;
+    // make root y (already detached from the root list) a child of x
+    void link(NodeId y, NodeId x) {
+        Node& Y = pool[y];
+        Node& X = pool[x];
+        HEAP_STATS_MOVE(1);
+        if (X.child != NIL_NODE) {
+            Node& c = pool[X.child];
+            Y.left = X.child;
+            Y.right = c.right;
+            pool[c.right].left = y;
+            c.right = y;
         } else {
-            x->child = y;
-            y->left = y->right = y;
+            X.child = y;
+            Y.left = Y.right = y;
         }
-        y->parent = x;
-        x->degree++;
-        y->marked = false;
+        Y.parent = x;
+        X.degree++;
+        Y.marked = false;
+        linkCount++;
     }
 
+    // max degree is at most log_phi(n): table size = largest d with F(d+2) <= n, plus slack
+    static int degreeBound(int n) {
+        int d = 0;
+        long long a = 1, b = 2;
+        while (b <= n) {
+            long long c = a + b;
+            a = b;
+            b = c;
+            d++;
+        }
+        return d + 2;
+    }
+
+    // walk the root ring once, detaching each root and linking equal degrees through
+    // the member degree table; then rebuild the ring from the used part of the table
     void consolidate() {
-        if (!minNode) return;
-        int maxDegree = (int)(2 * log2(n + 1)) + 2;
-        vector<Node*> A((size_t)maxDegree, nullptr);
-
-        Node* start = minNode;
-        vector<Node*> roots;
-        Node* p = start;
-        int count = 0;
-        do {
-            roots.push_back(p);
-            p = p->right;
-            if (++count > n) break;
-        } while (p != start);
-
-        for (Node* w : roots) {
-            Node* x = w;
-            int d = x->degree;
+        if (minNode == NIL_NODE) return;
+        NodeId w = minNode;
+        pool[pool[w].left].right = NIL_NODE;  // open the ring so the walk stops at NIL
+        int maxUsed = -1;
+        size_t roots = 0;
+
+        while (w != NIL_NODE) {
+            roots++;
+            NodeId next = pool[w].right;
+            NodeId x = w;
+            int d = pool[x].degree;
             while (true) {
-                if ((size_t)d >= A.size())
-                    A.resize(A.size() * 2 + 1, nullptr);
-                if (!A[d]) break;
-                Node* y = A[d];
-                if (x->key > y->key) swap(x, y);
+                if (d >= (int)degreeTable.size())
+                    degreeTable.resize(d + 1, NIL_NODE);
+                NodeId y = degreeTable[d];
+                if (y == NIL_NODE) break;
+                HEAP_STATS_COMPARE(1);
+                if (pool[x].key > pool[y].key) swap(x, y);
                 link(y, x);
-                A[d] = nullptr;
+                degreeTable[d] = NIL_NODE;
                 d++;
             }
-            if ((size_t)d >= A.size())
-                A.resize(A.size() * 2 + 1, nullptr);
-            A[d] = x;
+            degreeTable[d] = x;
+            if (d > maxUsed) maxUsed = d;
+            w = next;
         }
+        HEAP_STATS_SHAPE(roots);
 
-        minNode = nullptr;
-        for (Node* node : A) {
-            if (node) {
-                node->left = node->right = node;
-                node->parent = nullptr;
-                if (!minNode) {
-                    minNode = node;
-                } else {
-                    addToRootList(node);
-                    if (node->key < minNode->key)
-                        minNode = node;
-                }
-            }
+        minNode = NIL_NODE;
+        for (int d = 0; d <= maxUsed; d++) {
+            NodeId x = degreeTable[d];
+            if (x == NIL_NODE) continue;
+            degreeTable[d] = NIL_NODE;
+            addToRootList(x);
+            HEAP_STATS_COMPARE(1);
+            if (pool[x].key < pool[minNode].key)
+                minNode = x;
         }
     }
 
-    void cut(Node* x, Node* y) {
-        if (x->right == x)
-            y->child = nullptr;
+    void cut(NodeId x, NodeId y) {
+        Node& X = pool[x];
+        Node& Y = pool[y];
+        HEAP_STATS_MOVE(1);
+        if (X.right == x)
+            Y.child = NIL_NODE;
         else {
             removeFromList(x);
-            if (y->child == x)
-                y->child = x->right;
+            if (Y.child == x)
+                Y.child = X.right;
         }
-        y->degree--;
+        Y.degree--;
         addToRootList(x);
-        x->marked = false;
+        X.marked = false;
+        cutCount++;
     }
 
-    void cascadingCut(Node* y) {
-        for (Node* z = y->parent; z; z = y->parent) {
-            if (!y->marked) {
-                y->marked = true;
+    void cascadingCut(NodeId y) {
+        for (NodeId z = pool[y].parent; z != NIL_NODE; z = pool[y].parent) {
+            if (!pool[y].marked) {
+                pool[y].marked = true;
                 return;
             }
             cut(y, z);
@@ -138,72 +160,98 @@ private:
     }
 
 public:
-    FibonacciHeap() : minNode(nullptr), n(0), opCount(0) {}
-    explicit FibonacciHeap(int maxVertices) : minNode(nullptr), n(0), opCount(0) {
-        nodeMapping.resize(maxVertices, nullptr);
+    FibonacciHeap() : minNode(NIL_NODE), n(0), degreeTable(degreeBound(0), NIL_NODE),
+                      opCount(0), linkCount(0), cutCount(0), extractCount(0) {}
+    explicit FibonacciHeap(int maxVertices)
+        : pool(maxVertices), minNode(NIL_NODE), n(0), degreeTable(degreeBound(maxVertices), NIL_NODE),
+          opCount(0), linkCount(0), cutCount(0), extractCount(0) {
+        nodeMapping.resize(maxVertices, NIL_NODE);
     }
 
     void insert(int key, T value) override {
-        Node* newNode = new Node(key, value);
+        HEAP_STATS_OP(HEAP_INSERT);
+        NodeId id = pool.allocate();
+        Node& node = pool[id];
+        node.key = key;
+        node.value = value;
+        node.degree = 0;
+        node.marked = false;
+        node.parent = node.child = NIL_NODE;
+        node.left = node.right = id;
         if (!nodeMapping.empty() && value >= 0 && value < (int)nodeMapping.size())
-            nodeMapping[value] = newNode;
-        addToRootList(newNode);
-        if (!minNode || key < minNode->key)
-            minNode = newNode;
+            nodeMapping[value] = id;
+        addToRootList(id);
+        HEAP_STATS_COMPARE(1);
+        HEAP_STATS_MOVE(1);
+        if (minNode == NIL_NODE || key < pool[minNode].key)
+            minNode = id;
         n++;
         opCount++;
     }
 
     bool extractMin(int &outKey, T &outValue) override {
-        if (!minNode) return false;
-        outKey = minNode->key;
-        outValue = minNode->value;
+        if (minNode == NIL_NODE) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        outKey = pool[minNode].key;
+        outValue = pool[minNode].value;
         if (!nodeMapping.empty() && outValue >= 0 && outValue < (int)nodeMapping.size())
-            nodeMapping[outValue] = nullptr;
+            nodeMapping[outValue] = NIL_NODE;
 
-        if (minNode->child) {
-            Node* c = minNode->child;
+        NodeId firstChild = pool[minNode].child;
+        if (firstChild != NIL_NODE) {
+            NodeId c = firstChild;
             do {
-                Node* next = c->right;
+                NodeId next = pool[c].right;
+                HEAP_STATS_MOVE(1);
                 addToRootList(c);
                 c = next;
-            } while (c != minNode->child);
-            minNode->child = nullptr;
+            } while (c != firstChild);
+            pool[minNode].child = NIL_NODE;
         }
 
-        Node* oldMin = minNode;
-        if (minNode->right == minNode) {
-            minNode = nullptr;
+        NodeId oldMin = minNode;
+        if (pool[minNode].right == minNode) {
+            minNode = NIL_NODE;
         } else {
             removeFromList(minNode);
-            minNode = oldMin->right;
+            minNode = pool[oldMin].right;
             consolidate();
         }
-        delete oldMin;
+        pool.release(oldMin);
         n--;
         opCount++;
+        extractCount++;
         return true;
     }
 
     void decreaseKey(T value, int newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
         if (nodeMapping.empty() || value < 0 || value >= (int)nodeMapping.size()) return;
-        Node* node = nodeMapping[value];
-        if (!node) return;
-        if (newKey >= node->key) return;
-
-        node->key = newKey;
-        Node* parent = node->parent;
-        if (parent && newKey < parent->key) {
-            cut(node, parent);
+        NodeId id = nodeMapping[value];
+        if (id == NIL_NODE) return;
+        Node& node = pool[id];
+        if (newKey >= node.key) return;
+
+        node.key = newKey;
+        NodeId parent = node.parent;
+        HEAP_STATS_COMPARE(2);
+        if (parent != NIL_NODE && newKey < pool[parent].key) {
+            cut(id, parent);
             cascadingCut(parent);
         }
-        if (newKey < minNode->key)
-            minNode = node;
+        if (newKey < pool[minNode].key)
+            minNode = id;
         opCount++;
     }
 
-    bool isEmpty() const override { return minNode == nullptr; }
+    bool isEmpty() const override { return minNode == NIL_NODE; }
     long getOperationCount() const override { return opCount; }
+
+    // instrumentation for checking the amortized bounds: every link removes a root created
+    // by an insert, a cut or a promoted child, and links per extract should stay O(log n)
+    long getLinkCount() const { return linkCount; }
+    long getCutCount() const { return cutCount; }
+    long getExtractCount() const { return extractCount; }
 };
 
 #endif
@@ -9,6 +9,25 @@ struct Edge {
     int weight;
 };
 
+// removes the first arc to target, if any, by moving the last arc into its slot
+// (arc order is not kept; adjacency lists that change under updates use this)
+inline void eraseArc(vector<Edge>& arcs, int target) {
+    for (size_t i = 0; i < arcs.size(); i++) {
+        if (arcs[i].target == target) {
+            arcs[i] = arcs.back();
+            arcs.pop_back();
+            return;
+        }
+    }
+}
+
+// undirected edge as a pair of endpoints (edge lists, generators, MST)
+struct WeightedEdge {
+    int u;
+    int v;
+    int weight;
+};
+
 class Graph {
 public:
     int numVertices;
@@ -26,6 +45,9 @@ public:
         adjList[u].push_back({v, weight});
         adjList[v].push_back({u, weight});
     }
+
+    // same accessor as CSRGraph so the algorithms work on either layout
+    const vector<Edge>& neighbors(int u) const { return adjList[u]; }
 };
 
 #endif
@@ -0,0 +1,182 @@
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+using std::vector;
+
+// stateless counter-based random numbers (splitmix64 of key + i): at(i) depends only
+// on the key and i, so every thread draws its own slice of a stream with no shared
+// state and the values do not depend on who draws them
+struct CounterRNG {
+    uint64_t key;
+
+    CounterRNG(uint64_t seed, uint64_t stream) : key(mix(seed ^ mix(stream + 0x632BE59BD9B4E019ULL))) {}
+
+    uint64_t at(uint64_t i) const { return mix(key + i * 0x9E3779B97F4A7C15ULL); }
+
+    // r scaled into [0, bound) (multiply-shift, no modulo)
+    static uint32_t below(uint32_t r, uint32_t bound) { return (uint32_t)(((uint64_t)r * bound) >> 32); }
+
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+// benchmark graph families (undirected, weights 1..100). each generator fills a
+// presized edge list in parallel: edge i is a pure function of (seed, i), so the
+// list is bit-identical for a seed whatever the pool size. toGraph / toCSR then
+// store every edge at both endpoints in edge order, i.e. the lists the
+// addUndirectedEdge calls would build one by one, with storage sized up front.
+class GraphGenerators {
+public:
+    // edgeMultiplier*n edges with uniform endpoints (never a self-loop)
+    static vector<WeightedEdge> randomSparse(int n, int edgeMultiplier, uint64_t seed, ThreadPool& pool) {
+        return uniformEdges(n, (long long)n * edgeMultiplier, seed, pool);
+    }
+
+    // edgeFraction of the n(n-1)/2 possible edges, uniform endpoints (duplicates allowed)
+    static vector<WeightedEdge> randomDense(int n, double edgeFraction, uint64_t seed, ThreadPool& pool) {
+        long long maxEdges = (long long)n * (n - 1) / 2;
+        return uniformEdges(n, (long long)(maxEdges * edgeFraction), seed, pool);
+    }
+
+    // rows*cols 4-neighbour grid; per vertex the right then the down edge, row by row
+    static vector<WeightedEdge> grid(int rows, int cols, uint64_t seed, ThreadPool& pool) {
+        long long perRow = 2LL * cols - 1;  // cols-1 right + cols down (last row: right only)
+        vector<WeightedEdge> edges((size_t)(perRow * (rows - 1) + (cols - 1)));
+        CounterRNG rng(seed, 0);
+        pool.parallelFor(rows, [&](int, int r) {
+            size_t i = (size_t)(perRow * r);
+            for (int c = 0; c < cols; c++) {
+                int u = r * cols + c;
+                if (c + 1 < cols) {
+                    edges[i] = { u, u + 1, weight(rng, i) };
+                    i++;
+                }
+                if (r + 1 < rows) {
+                    edges[i] = { u, u + cols, weight(rng, i) };
+                    i++;
+                }
+            }
+        });
+        return edges;
+    }
+
+    // sqrt(n) layers, complete bipartite between adjacent layers (stresses decreaseKey)
+    static vector<WeightedEdge> layered(int n, uint64_t seed, ThreadPool& pool) {
+        if (n <= 1) return vector<WeightedEdge>();
+        int L = std::max(2, (int)std::sqrt(n));
+        int perLayer = (n + L - 1) / L;
+        vector<int> layerStart(L + 1);
+        for (int i = 0; i <= L; i++)
+            layerStart[i] = std::min(i * perLayer, n);
+        vector<long long> first(L, 0);  // index of the first edge out of each layer
+        for (int i = 0; i + 1 < L; i++) {
+            long long sources = layerStart[i + 1] - layerStart[i];
+            first[i + 1] = first[i] + sources * (layerStart[i + 2] - layerStart[i + 1]);
+        }
+
+        vector<WeightedEdge> edges((size_t)first[L - 1]);
+        CounterRNG rng(seed, 0);
+        int lastSource = layerStart[L - 1];  // vertices of the last layer have no forward edges
+        pool.parallelFor(lastSource, [&](int, int u) {
+            int layer = u / perLayer;
+            int b = layerStart[layer + 1], bEnd = layerStart[layer + 2];
+            size_t i = (size_t)(first[layer] + (long long)(u - layerStart[layer]) * (bEnd - b));
+            for (int v = b; v < bEnd; v++, i++)
+                edges[i] = { u, v, weight(rng, i) };
+        });
+        return edges;
+    }
+
+    // adjacency lists sized from a degree count, then filled in edge order
+    static Graph toGraph(int n, const vector<WeightedEdge>& edges, ThreadPool& pool) {
+        vector<int> degree = degrees(n, edges, pool);
+        Graph g(n);
+        pool.parallelFor(numChunks(n), [&](int, int c) {
+            int end = std::min(n, (c + 1) * VERTEX_CHUNK);
+            for (int v = c * VERTEX_CHUNK; v < end; v++)
+                g.adjList[v].reserve(degree[v]);
+        });
+        for (const WeightedEdge& e : edges) {
+            g.adjList[e.u].push_back({ e.v, e.weight });
+            g.adjList[e.v].push_back({ e.u, e.weight });
+        }
+        return g;
+    }
+
+    // CSR straight from the edge list (no adjacency list in between), same edge order as toGraph
+    static CSRGraph toCSR(int n, const vector<WeightedEdge>& edges, ThreadPool& pool) {
+        vector<int> degree = degrees(n, edges, pool);
+        CSRGraph g;
+        g.numVertices = n;
+        g.offsets.assign((size_t)n + 1, 0);
+        for (int v = 0; v < n; v++)
+            g.offsets[v + 1] = g.offsets[v] + degree[v];
+        g.edges.resize((size_t)g.offsets[n]);
+        vector<long long> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (const WeightedEdge& e : edges) {
+            g.edges[(size_t)cursor[e.u]++] = { e.v, e.weight };
+            g.edges[(size_t)cursor[e.v]++] = { e.u, e.weight };
+        }
+        return g;
+    }
+
+private:
+    static constexpr size_t EDGE_CHUNK = 1 << 16;
+    static constexpr int VERTEX_CHUNK = 4096;
+
+    static int numChunks(int n) { return (n + VERTEX_CHUNK - 1) / VERTEX_CHUNK; }
+
+    static int weight(const CounterRNG& rng, uint64_t i) {
+        return 1 + (int)CounterRNG::below((uint32_t)rng.at(i), 100);
+    }
+
+    // edge i: endpoints from the high and low halves of one draw, weight from a second stream
+    static vector<WeightedEdge> uniformEdges(int n, long long count, uint64_t seed, ThreadPool& pool) {
+        if (n < 2 || count <= 0) return vector<WeightedEdge>();
+        vector<WeightedEdge> edges((size_t)count);
+        CounterRNG ends(seed, 0), weights(seed, 1);
+        int chunks = (int)((edges.size() + EDGE_CHUNK - 1) / EDGE_CHUNK);
+        pool.parallelFor(chunks, [&](int, int c) {
+            size_t end = std::min(edges.size(), (size_t)(c + 1) * EDGE_CHUNK);
+            for (size_t i = (size_t)c * EDGE_CHUNK; i < end; i++) {
+                uint64_t r = ends.at(i);
+                int u = (int)CounterRNG::below((uint32_t)(r >> 32), (uint32_t)n);
+                int v = (int)CounterRNG::below((uint32_t)r, (uint32_t)n - 1);
+                if (v >= u) v++;
+                edges[i] = { u, v, weight(weights, i) };
+            }
+        });
+        return edges;
+    }
+
+    // per-vertex degree (both endpoints); atomic counts are order-independent
+    static vector<int> degrees(int n, const vector<WeightedEdge>& edges, ThreadPool& pool) {
+        std::unique_ptr<std::atomic<int>[]> count(new std::atomic<int>[n]);
+        for (int v = 0; v < n; v++) count[v].store(0, std::memory_order_relaxed);
+        int chunks = (int)((edges.size() + EDGE_CHUNK - 1) / EDGE_CHUNK);
+        pool.parallelFor(chunks, [&](int, int c) {
+            size_t end = std::min(edges.size(), (size_t)(c + 1) * EDGE_CHUNK);
+            for (size_t i = (size_t)c * EDGE_CHUNK; i < end; i++) {
+                count[edges[i].u].fetch_add(1, std::memory_order_relaxed);
+                count[edges[i].v].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        vector<int> degree(n);
+        for (int v = 0; v < n; v++) degree[v] = count[v].load(std::memory_order_relaxed);
+        return degree;
+    }
+};
+
+#endif
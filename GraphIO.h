@@ -0,0 +1,338 @@
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#define GRAPH_IO_NO_MMAP
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using std::vector;
+using std::string;
+
+// binary CSR file, read in place by MappedCSRGraph (native byte order, checked):
+//   64-byte CSRFileHeader
+//   offsets: numVertices + 1 int64 at offsetsPos (64)
+//   edges:   numEdges Edge{int32 target, int32 weight} at edgesPos (64-byte aligned)
+// version bumps whenever the layout changes; readers reject versions they do not know.
+const uint32_t CSR_FILE_VERSION = 1;
+const uint32_t CSR_FILE_BYTE_ORDER = 0x01020304u;
+
+struct CSRFileHeader {
+    char magic[4];  // "CSRG"
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t edgeBytes;
+    uint64_t numVertices;
+    uint64_t numEdges;
+    uint64_t offsetsPos;
+    uint64_t edgesPos;
+    uint64_t reserved[2];
+};
+static_assert(sizeof(CSRFileHeader) == 64, "CSRFileHeader must stay 64 bytes");
+static_assert(sizeof(long long) == 8 && sizeof(Edge) == 8, "binary CSR layout assumes 64-bit offsets, 8-byte edges");
+
+// text importers and the binary CSR writer. importers fill any G constructible
+// from a vertex count with addEdge(u, v, w) (Graph or CSRBuilder); g is replaced.
+// they read the whole file at once and scan it by hand, no per-line allocation.
+class GraphIO {
+public:
+    // DIMACS shortest-path format: "c" comments, "p sp n m", then m lines "a u v w"
+    // (1-based ids, directed arcs; road graphs list both directions)
+    template <typename G>
+    static bool readDimacs(const string& path, G& g, string& error) {
+        string text;
+        if (!readFile(path, text, error)) return false;
+        Scanner s(text);
+        bool haveHeader = false;
+        long long n = 0, m = 0, arcs = 0;
+        while (s.nextLine()) {
+            char c = *s.p;
+            if (c == 'c') continue;
+            s.p++;
+            if (c == 'p') {
+                s.skipWord();  // problem type, "sp"
+                if (haveHeader || !s.readInt(n) || !s.readInt(m) || n < 1 || n > INT32_MAX_ || m < 0)
+                    return fail(error, path, s.line, "bad problem line");
+                g = G((int)n);
+                haveHeader = true;
+            } else if (c == 'a') {
+                long long u, v, w;
+                if (!haveHeader) return fail(error, path, s.line, "arc before problem line");
+                if (!s.readInt(u) || !s.readInt(v) || !s.readInt(w))
+                    return fail(error, path, s.line, "bad arc line");
+                if (u < 1 || u > n || v < 1 || v > n) return fail(error, path, s.line, "vertex id out of range");
+                if (w < 0 || w > INT32_MAX_) return fail(error, path, s.line, "weight must be 0..2^31-1");
+                g.addEdge((int)(u - 1), (int)(v - 1), (int)w);
+                arcs++;
+            } else {
+                return fail(error, path, s.line, "expected c, p or a line");
+            }
+            if (!s.atLineEnd()) return fail(error, path, s.line, "trailing text");
+        }
+        if (!haveHeader) return fail(error, path, s.line, "no problem line");
+        if (arcs != m) return fail(error, path, s.line, "arc count differs from problem line");
+        return true;
+    }
+
+    // plain edge list: "u v [w]" per line, 0-based ids, weight 1 when omitted,
+    // "#" and "%" lines are comments. numVertices = largest id + 1.
+    // undirected adds both directions of every line.
+    template <typename G>
+    static bool readEdgeList(const string& path, G& g, bool undirected, string& error) {
+        string text;
+        if (!readFile(path, text, error)) return false;
+        Scanner s(text);
+        vector<int> from, to, weight;
+        long long maxId = -1;
+        while (s.nextLine()) {
+            if (*s.p == '#' || *s.p == '%') continue;
+            long long u, v, w = 1;
+            if (!s.readInt(u) || !s.readInt(v)) return fail(error, path, s.line, "expected \"u v [w]\"");
+            if (!s.atLineEnd() && !s.readInt(w)) return fail(error, path, s.line, "bad weight");
+            if (!s.atLineEnd()) return fail(error, path, s.line, "trailing text");
+            if (u < 0 || v < 0 || u >= INT32_MAX_ || v >= INT32_MAX_)
+                return fail(error, path, s.line, "vertex id out of range");
+            if (w < 0 || w > INT32_MAX_) return fail(error, path, s.line, "weight must be 0..2^31-1");
+            from.push_back((int)u);
+            to.push_back((int)v);
+            weight.push_back((int)w);
+            if (u > maxId) maxId = u;
+            if (v > maxId) maxId = v;
+        }
+        if (maxId < 0) return fail(error, path, s.line, "no edges");
+        g = G((int)(maxId + 1));
+        for (size_t i = 0; i < from.size(); i++) {
+            if (undirected) g.addUndirectedEdge(from[i], to[i], weight[i]);
+            else g.addEdge(from[i], to[i], weight[i]);
+        }
+        return true;
+    }
+
+    static bool writeBinaryCSR(const string& path, const CSRGraph& g, string& error) {
+        CSRFileHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, "CSRG", 4);
+        h.version = CSR_FILE_VERSION;
+        h.byteOrder = CSR_FILE_BYTE_ORDER;
+        h.edgeBytes = sizeof(Edge);
+        h.numVertices = (uint64_t)g.numVertices;
+        h.numEdges = (uint64_t)g.numEdges();
+        h.offsetsPos = sizeof(CSRFileHeader);
+        h.edgesPos = (h.offsetsPos + 8 * (h.numVertices + 1) + 63) & ~(uint64_t)63;
+
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f) {
+            error = "cannot create " + path;
+            return false;
+        }
+        static const char zeros[64] = {};
+        size_t pad = (size_t)(h.edgesPos - h.offsetsPos - 8 * (h.numVertices + 1));
+        bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+               && fwrite(g.offsets.data(), 8, g.offsets.size(), f) == g.offsets.size()
+               && fwrite(zeros, 1, pad, f) == pad
+               && fwrite(g.edges.data(), sizeof(Edge), g.edges.size(), f) == g.edges.size();
+        if (fclose(f) != 0) ok = false;
+        if (!ok) error = "write failed for " + path;
+        return ok;
+    }
+
+    // adjacency-list copy of any CSR-like graph, same per-vertex edge order
+    template <typename GraphT>
+    static Graph toAdjacencyList(const GraphT& csr) {
+        Graph g(csr.numVertices);
+        for (int u = 0; u < csr.numVertices; u++)
+            for (const auto& e : csr.neighbors(u))
+                g.adjList[u].push_back(e);
+        return g;
+    }
+
+private:
+    static constexpr long long INT32_MAX_ = 2147483647LL;
+
+    static bool readFile(const string& path, string& text, string& error) {
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) {
+            error = "cannot open " + path;
+            return false;
+        }
+        text.clear();
+        char buf[1 << 16];
+        size_t got;
+        while ((got = fread(buf, 1, sizeof(buf), f)) > 0)
+            text.append(buf, got);
+        fclose(f);
+        return true;
+    }
+
+    static bool fail(string& error, const string& path, long line, const char* what) {
+        error = path + ":" + std::to_string(line) + ": " + what;
+        return false;
+    }
+
+    // line-oriented cursor over the file text
+    struct Scanner {
+        const char* p;
+        const char* end;
+        const char* next;  // start of the line after the current one
+        long line;
+
+        explicit Scanner(const string& text)
+            : p(text.data()), end(text.data() + text.size()), next(text.data()), line(0) {}
+
+        // moves to the next non-blank line; false at end of file
+        bool nextLine() {
+            while (next < end) {
+                p = next;
+                line++;
+                const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+                next = nl ? nl + 1 : end;
+                skipSpaces();
+                if (p < end && *p != '\n') return true;
+            }
+            return false;
+        }
+
+        void skipSpaces() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        }
+
+        void skipWord() {
+            skipSpaces();
+            while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') p++;
+        }
+
+        bool atLineEnd() {
+            skipSpaces();
+            return p >= end || *p == '\n';
+        }
+
+        bool readInt(long long& v) {
+            skipSpaces();
+            bool neg = p < end && *p == '-';
+            if (neg) p++;
+            if (p >= end || *p < '0' || *p > '9') return false;
+            v = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                v = v * 10 + (*p - '0');
+                if (v > 4 * INT32_MAX_) return false;
+                p++;
+            }
+            if (neg) v = -v;
+            return true;
+        }
+    };
+};
+
+// read-only graph over a binary CSR file mapped into memory: no parsing and no
+// copy, pages are faulted in as the algorithms touch them. same interface as
+// CSRGraph (numVertices, neighbors, numEdges). open() checks the header and that
+// the file is long enough; the arrays themselves are trusted.
+class MappedCSRGraph {
+public:
+    int numVertices;
+
+    MappedCSRGraph() : numVertices(0), base(nullptr), length(0), offsets(nullptr), edges(nullptr) {}
+    ~MappedCSRGraph() { close(); }
+
+    MappedCSRGraph(const MappedCSRGraph&) = delete;
+    MappedCSRGraph& operator=(const MappedCSRGraph&) = delete;
+
+    bool open(const string& path, string& error) {
+        close();
+#ifdef GRAPH_IO_NO_MMAP
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) return fail(error, "cannot open " + path);
+        fseek(f, 0, SEEK_END);
+        length = (size_t)ftell(f);
+        fseek(f, 0, SEEK_SET);
+        fallback.resize(length / 8 + 1);
+        bool read = fread(fallback.data(), 1, length, f) == length;
+        fclose(f);
+        if (!read) return fail(error, "cannot read " + path);
+        base = fallback.data();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return fail(error, "cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(CSRFileHeader)) {
+            ::close(fd);
+            return fail(error, path + ": not a binary CSR graph");
+        }
+        length = (size_t)st.st_size;
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            length = 0;
+            return fail(error, "mmap failed for " + path);
+        }
+        base = p;
+#endif
+        if (length < sizeof(CSRFileHeader)) return fail(error, path + ": not a binary CSR graph");
+        CSRFileHeader h;
+        memcpy(&h, base, sizeof(h));
+        if (memcmp(h.magic, "CSRG", 4) != 0) return fail(error, path + ": not a binary CSR graph");
+        if (h.byteOrder != CSR_FILE_BYTE_ORDER) return fail(error, path + ": written on a machine with other byte order");
+        if (h.version != CSR_FILE_VERSION || h.edgeBytes != sizeof(Edge))
+            return fail(error, path + ": unsupported binary CSR version " + std::to_string(h.version));
+        // sizes compared by division so huge header fields cannot wrap the sums
+        if (h.numVertices < 1 || h.numVertices > 2147483647ULL || h.offsetsPos % 8 || h.edgesPos % 8 ||
+            h.offsetsPos > length || (length - h.offsetsPos) / 8 < h.numVertices + 1 ||
+            h.edgesPos > length || (length - h.edgesPos) / 8 < h.numEdges)
+            return fail(error, path + ": truncated or inconsistent binary CSR file");
+        const char* bytes = (const char*)base;
+        offsets = (const long long*)(bytes + h.offsetsPos);
+        edges = (const Edge*)(bytes + h.edgesPos);
+        if (offsets[0] != 0 || offsets[h.numVertices] != (long long)h.numEdges)
+            return fail(error, path + ": offsets do not match the edge count");
+        // one sequential pass over both arrays, so neighbors() never leaves the mapping
+        for (uint64_t u = 0; u < h.numVertices; u++)
+            if (offsets[u + 1] < offsets[u])
+                return fail(error, path + ": offsets not monotone at vertex " + std::to_string(u));
+        for (uint64_t i = 0; i < h.numEdges; i++)
+            if (edges[i].target < 0 || (uint64_t)edges[i].target >= h.numVertices)
+                return fail(error, path + ": edge " + std::to_string(i) + " has target out of range");
+        numVertices = (int)h.numVertices;
+        return true;
+    }
+
+    EdgeSpan neighbors(int u) const { return { edges + offsets[u], edges + offsets[u + 1] }; }
+    long long numEdges() const { return numVertices ? offsets[numVertices] : 0; }
+
+private:
+    void* base;
+    size_t length;
+    const long long* offsets;
+    const Edge* edges;
+#ifdef GRAPH_IO_NO_MMAP
+    vector<uint64_t> fallback;  // 8-byte aligned copy when mmap is unavailable
+#endif
+
+    void close() {
+#ifndef GRAPH_IO_NO_MMAP
+        if (base) munmap(base, length);
+#endif
+        base = nullptr;
+        length = 0;
+        offsets = nullptr;
+        edges = nullptr;
+        numVertices = 0;
+    }
+
+    bool fail(string& error, const string& what) {
+        error = what;
+        close();
+        return false;
+    }
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <cstdint>
+#include <chrono>
+
+// opt-in per-operation instrumentation. build with -DHEAP_STATS and every
+// PriorityQueue carries a HeapStats (getStats()) filled through the HEAP_STATS_*
+// hooks below; without it the hooks expand to unevaluated no-ops and the heaps
+// compile exactly as before. with it, every operation also reads the clock twice,
+// so run times are not comparable to an uninstrumented build.
+
+enum HeapOp { HEAP_INSERT, HEAP_EXTRACT_MIN, HEAP_DECREASE_KEY, NUM_HEAP_OPS };
+
+inline const char* heapOpName(int op) {
+    static const char* const names[] = { "insert", "extractMin", "decreaseKey" };
+    return names[op];
+}
+
+// hdr-style log-linear histogram of nanosecond latencies: exact below 16 ns, then
+// 16 sub-buckets per power of two (relative error <= 1/16), values clamped at 2^40 ns
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 4;
+    static const int SUB = 1 << SUB_BITS;
+    static const int MAX_BITS = 40;
+    static const int NUM_BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB;
+
+    LatencyHistogram() : counts(), total(0), maxNs(0) {}
+
+    void record(uint64_t ns) {
+        if (ns > maxNs) maxNs = ns;
+        counts[bucketOf(ns)]++;
+        total++;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxNs; }
+    uint64_t bucketCount(int b) const { return counts[b]; }
+
+    // smallest recorded value (bucket lower bound) with at least q of the samples at or below it
+    uint64_t percentile(double q) const {
+        if (total == 0) return 0;
+        uint64_t target = (uint64_t)(q * total);
+        if (target < 1) target = 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < NUM_BUCKETS; b++) {
+            seen += counts[b];
+            if (seen >= target) return bucketLow(b);
+        }
+        return maxNs;
+    }
+
+    static int bucketOf(uint64_t v) {
+        const uint64_t limit = ((uint64_t)1 << MAX_BITS) - 1;
+        if (v > limit) v = limit;
+        if (v < (uint64_t)SUB) return (int)v;
+        int msb = 0;
+        for (uint64_t x = v; x >>= 1; ) msb++;
+        int shift = msb - SUB_BITS;
+        return (shift + 1) * SUB + (int)((v >> shift) - SUB);
+    }
+
+    static uint64_t bucketLow(int b) {
+        if (b < SUB) return (uint64_t)b;
+        int shift = b / SUB - 1;
+        return (uint64_t)(SUB + b % SUB) << shift;
+    }
+
+private:
+    uint64_t counts[NUM_BUCKETS];
+    uint64_t total;
+    uint64_t maxNs;
+};
+
+// calls, latency, key comparisons and moves per operation type. a move is one
+// array slot written (array heaps), one node relinked (pairing, fibonacci) or one
+// bucket push (radix, dial). extract shape is the per-heap size of the structure
+// extractMin has to repair: depth for array heaps, roots combined for pairing and
+// fibonacci, entries redistributed for radix, buckets scanned for dial.
+struct HeapStats {
+    struct OpStats {
+        uint64_t calls;
+        uint64_t comparisons;
+        uint64_t moves;
+        LatencyHistogram latency;
+
+        OpStats() : calls(0), comparisons(0), moves(0) {}
+    };
+
+    OpStats ops[NUM_HEAP_OPS];
+    uint64_t extractShapeSum;
+    uint64_t extractShapeMax;
+    int current;  // operation the compare/move hooks are charged to
+
+    HeapStats() : extractShapeSum(0), extractShapeMax(0), current(HEAP_INSERT) {}
+
+    void compare(uint64_t n) { ops[current].comparisons += n; }
+    void move(uint64_t n) { ops[current].moves += n; }
+
+    void extractShape(uint64_t size) {
+        extractShapeSum += size;
+        if (size > extractShapeMax) extractShapeMax = size;
+    }
+
+    // times one public operation and charges the hooks it runs to that operation
+    class Scope {
+    public:
+        Scope(HeapStats& stats, HeapOp op)
+            : s(stats), op(op), prev(stats.current), t0(std::chrono::steady_clock::now()) {
+            s.current = op;
+        }
+        ~Scope() {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0);
+            s.ops[op].latency.record((uint64_t)ns.count());
+            s.ops[op].calls++;
+            s.current = prev;
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        HeapStats& s;
+        HeapOp op;
+        int prev;
+        std::chrono::steady_clock::time_point t0;
+    };
+};
+
+// levels below the root of a complete arity-ary heap holding size entries
+inline uint64_t heapDepth(uint64_t size, uint64_t arity) {
+    uint64_t depth = 0, reach = 1, level = 1;
+    while (reach < size) {
+        level *= arity;
+        reach += level;
+        depth++;
+    }
+    return depth;
+}
+
+// hooks for heap member functions (they use this->stats from PriorityQueue)
+#ifdef HEAP_STATS
+#define HEAP_STATS_OP(op) HeapStats::Scope heapStatsScope_(this->stats, op)
+#define HEAP_STATS_COMPARE(n) (this->stats.compare(n))
+#define HEAP_STATS_MOVE(n) (this->stats.move(n))
+#define HEAP_STATS_SHAPE(size) (this->stats.extractShape(size))
+#else
+#define HEAP_STATS_OP(op) ((void)0)
+#define HEAP_STATS_COMPARE(n) ((void)sizeof(n))
+#define HEAP_STATS_MOVE(n) ((void)sizeof(n))
+#define HEAP_STATS_SHAPE(size) ((void)sizeof(size))
+#endif
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+#include "PriorityQueue.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+using std::vector;
+using std::string;
+
+enum TraceOpKind : uint8_t { TRACE_INSERT, TRACE_EXTRACT_MIN, TRACE_DECREASE_KEY };
+
+// one heap call; for extractMin key/value are what the recorded heap returned
+struct TraceOp {
+    uint8_t kind;
+    int key;
+    int value;
+};
+
+// the exact operation sequence one algorithm run produced, for replaying against
+// other heaps without the graph. file layout (little endian):
+//   "HPQT", u32 version, u32 numVertices, u32 label length, label bytes, u64 op count,
+//   then per op: u8 kind, varint value, varint zigzag(key)
+class HeapTrace {
+public:
+    static const uint32_t VERSION = 1;
+
+    int numVertices;
+    string label;  // e.g. "Dijkstra,random,sparse,10000"
+    vector<TraceOp> ops;
+
+    HeapTrace() : numVertices(0) {}
+
+    void record(uint8_t kind, int key, int value) { ops.push_back({ kind, key, value }); }
+
+    // sum of recorded extractMin keys; a replay through a correct heap matches it
+    long long extractKeySum() const {
+        long long sum = 0;
+        for (const TraceOp& op : ops)
+            if (op.kind == TRACE_EXTRACT_MIN) sum += op.key;
+        return sum;
+    }
+
+    bool save(const string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        string buf = "HPQT";
+        putU32(buf, VERSION);
+        putU32(buf, (uint32_t)numVertices);
+        putU32(buf, (uint32_t)label.size());
+        buf += label;
+        for (int i = 0; i < 8; i++) buf.push_back((char)((uint64_t)ops.size() >> (8 * i)));
+        for (const TraceOp& op : ops) {
+            buf.push_back((char)op.kind);
+            putVarint(buf, (uint32_t)op.value);
+            putVarint(buf, zigzag(op.key));
+        }
+        out.write(buf.data(), (std::streamsize)buf.size());
+        return (bool)out;
+    }
+
+    // false with error set on a missing, foreign or truncated file, or on a vertex id
+    // outside 0..numVertices-1 (replays index the heaps' position maps with them)
+    bool load(const string& path, string& error) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            error = "cannot open " + path;
+            return false;
+        }
+        string buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t pos = 0;
+        uint32_t version = 0, n = 0, labelLen = 0;
+        if (buf.compare(0, 4, "HPQT") != 0) {
+            error = path + ": not a heap trace";
+            return false;
+        }
+        pos = 4;
+        if (!getU32(buf, pos, version) || version != VERSION) {
+            error = path + ": unsupported trace version";
+            return false;
+        }
+        if (!getU32(buf, pos, n) || !getU32(buf, pos, labelLen) || pos + labelLen + 8 > buf.size()) {
+            error = path + ": truncated header";
+            return false;
+        }
+        if (n > (uint32_t)INT32_MAX) {
+            error = path + ": vertex count out of range";
+            return false;
+        }
+        numVertices = (int)n;
+        label = buf.substr(pos, labelLen);
+        pos += labelLen;
+        uint64_t count = 0;
+        for (int i = 0; i < 8; i++) count |= (uint64_t)(unsigned char)buf[pos++] << (8 * i);
+
+        ops.clear();
+        ops.reserve((size_t)count);
+        for (uint64_t i = 0; i < count; i++) {
+            uint32_t value, key;
+            if (pos >= buf.size()) break;
+            uint8_t kind = (uint8_t)buf[pos++];
+            if (kind > TRACE_DECREASE_KEY || !getVarint(buf, pos, value) || !getVarint(buf, pos, key)) break;
+            if (value >= n) {
+                error = path + ": vertex id " + std::to_string(value) + " out of range (trace has " +
+                        std::to_string(n) + " vertices)";
+                return false;
+            }
+            ops.push_back({ kind, unzigzag(key), (int)value });
+        }
+        if (ops.size() != count) {
+            error = path + ": truncated or corrupt op stream";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static uint32_t zigzag(int v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+    static int unzigzag(uint32_t v) { return (int)(v >> 1) ^ -(int)(v & 1); }
+
+    static void putU32(string& buf, uint32_t v) {
+        for (int i = 0; i < 4; i++) buf.push_back((char)(v >> (8 * i)));
+    }
+
+    static bool getU32(const string& buf, size_t& pos, uint32_t& v) {
+        if (pos + 4 > buf.size()) return false;
+        v = 0;
+        for (int i = 0; i < 4; i++) v |= (uint32_t)(unsigned char)buf[pos++] << (8 * i);
+        return true;
+    }
+
+    static void putVarint(string& buf, uint32_t v) {
+        while (v >= 0x80) {
+            buf.push_back((char)(v | 0x80));
+            v >>= 7;
+        }
+        buf.push_back((char)v);
+    }
+
+    static bool getVarint(const string& buf, size_t& pos, uint32_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (pos >= buf.size()) return false;
+            unsigned char b = (unsigned char)buf[pos++];
+            v |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+// decorator that forwards to another heap and appends every call to a trace
+template <typename T>
+class RecordingQueue final : public PriorityQueue<T> {
+public:
+    RecordingQueue(PriorityQueue<T>& inner, HeapTrace& trace) : inner(inner), trace(trace) {}
+
+    void insert(int key, T value) override {
+        trace.record(TRACE_INSERT, key, (int)value);
+        inner.insert(key, value);
+    }
+
+    bool extractMin(int &outKey, T &outValue) override {
+        if (!inner.extractMin(outKey, outValue)) return false;
+        trace.record(TRACE_EXTRACT_MIN, outKey, (int)outValue);
+        return true;
+    }
+
+    void decreaseKey(T value, int newKey) override {
+        trace.record(TRACE_DECREASE_KEY, newKey, (int)value);
+        inner.decreaseKey(value, newKey);
+    }
+
+    bool isEmpty() const override { return inner.isEmpty(); }
+    long getOperationCount() const override { return inner.getOperationCount(); }
+
+private:
+    PriorityQueue<T>& inner;
+    HeapTrace& trace;
+};
+
+// replays a trace on a fresh HeapT(numVertices) through the concrete type (no
+// virtual calls, nothing but the heap in the loop). returns microseconds;
+// keySum gets the sum of extracted keys (compare with extractKeySum()).
+template <typename HeapT>
+double replayTrace(const HeapTrace& trace, long long& keySum) {
+    HeapT heap(trace.numVertices);
+    long long sum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const TraceOp& op : trace.ops) {
+        switch (op.kind) {
+        case TRACE_INSERT:
+            heap.insert(op.key, op.value);
+            break;
+        case TRACE_EXTRACT_MIN: {
+            int key, value;
+            if (heap.extractMin(key, value)) sum += key;
+            break;
+        }
+        default:
+            heap.decreaseKey(op.value, op.key);
+            break;
+        }
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    keySum = sum;
+    return us;
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef HOLLOW_HEAP_H
+#define HOLLOW_HEAP_H
+
+#include "PriorityQueue.h"
+#include "NodePool.h"
+#include <vector>
+using std::vector;
+
+// hollow heap (Hansen, Kaplan, Tarjan, Zwick), single-root version: heap-ordered
+// dag, O(1) insert and decreaseKey, O(log n) amortized extractMin. decreaseKey never
+// restructures: the item moves to a fresh node v linked against the root, and its old
+// node u stays behind hollow (no item) as v's last child, so u has two parents.
+// v takes rank max(0, rank(u) - 2). extractMin strips the hollow root and every
+// hollow node it frees up, then links full roots by rank (ranked links, winner's rank
+// +1) and finally all remaining roots unranked. hollow nodes hold pool slots until then.
+template <typename T>
+class HollowHeap final : public PriorityQueue<T> {
+private:
+    // links are pool indices (NIL_NODE = none)
+    struct Node {
+        int key;
+        T value;
+        bool hollow;
+        int rank;
+        NodeId child;  // last child added
+        NodeId next;   // next sibling
+        NodeId ep;     // second (extra) parent of a hollow node, else NIL
+    };
+
+    NodePool<Node> pool;
+    NodeId root;
+    vector<NodeId> nodeMapping;
+    vector<NodeId> rankTable;  // extractMin scratch, all NIL between calls
+    int maxRank;
+    long opCount;
+
+    NodeId makeNode(int key, T value) {
+        NodeId id = pool.allocate();
+        Node& node = pool[id];
+        node.key = key;
+        node.value = value;
+        node.hollow = false;
+        node.rank = 0;
+        node.child = node.next = node.ep = NIL_NODE;
+        if (!nodeMapping.empty() && value >= 0 && value < (int)nodeMapping.size())
+            nodeMapping[value] = id;
+        return id;
+    }
+
+    void addChild(NodeId c, NodeId p) {
+        HEAP_STATS_MOVE(1);
+        pool[c].next = pool[p].child;
+        pool[p].child = c;
+    }
+
+    // the larger key becomes the other's child; returns the winner
+    NodeId link(NodeId a, NodeId b) {
+        HEAP_STATS_COMPARE(1);
+        if (pool[a].key > pool[b].key) {
+            addChild(a, b);
+            return b;
+        }
+        addChild(b, a);
+        return a;
+    }
+
+    void rankedLinks(NodeId u) {
+        while (true) {
+            int r = pool[u].rank;
+            if (r >= (int)rankTable.size()) rankTable.resize(r + 1, NIL_NODE);
+            NodeId w = rankTable[r];
+            if (w == NIL_NODE) {
+                rankTable[r] = u;
+                if (r > maxRank) maxRank = r;
+                return;
+            }
+            rankTable[r] = NIL_NODE;
+            u = link(u, w);
+            pool[u].rank++;
+        }
+    }
+
+public:
+    HollowHeap() : root(NIL_NODE), rankTable(64, NIL_NODE), maxRank(-1), opCount(0) {}
+    explicit HollowHeap(int maxVertices)
+        : pool(maxVertices), root(NIL_NODE), rankTable(64, NIL_NODE), maxRank(-1), opCount(0) {
+        nodeMapping.resize(maxVertices, NIL_NODE);
+    }
+
+    void insert(int key, T value) override {
+        HEAP_STATS_OP(HEAP_INSERT);
+        NodeId id = makeNode(key, value);
+        root = root == NIL_NODE ? id : link(id, root);
+        opCount++;
+    }
+
+    bool extractMin(int &outKey, T &outValue) override {
+        if (root == NIL_NODE) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        outKey = pool[root].key;
+        outValue = pool[root].value;
+        if (!nodeMapping.empty() && outValue >= 0 && outValue < (int)nodeMapping.size())
+            nodeMapping[outValue] = NIL_NODE;
+        pool[root].hollow = true;
+
+        // destroy hollow roots one at a time (pending ones chained through next); their
+        // full children go to ranked linking, hollow children left with no parent join
+        // the pending chain, hollow children with a second parent just lose this one
+        size_t roots = 0;
+        maxRank = -1;
+        NodeId h = root;
+        pool[h].next = NIL_NODE;
+        while (h != NIL_NODE) {
+            NodeId w = pool[h].child;
+            NodeId v = h;
+            h = pool[h].next;
+            while (w != NIL_NODE) {
+                NodeId u = w;
+                Node& U = pool[u];
+                w = U.next;
+                if (U.hollow) {
+                    if (U.ep == NIL_NODE) {
+                        U.next = h;
+                        h = u;
+                    } else {
+                        // u is last in its ep's list; the rest of that list is not v's
+                        if (U.ep == v) w = NIL_NODE;
+                        else U.next = NIL_NODE;
+                        U.ep = NIL_NODE;
+                    }
+                } else {
+                    rankedLinks(u);
+                    roots++;
+                }
+            }
+            pool.release(v);
+        }
+        HEAP_STATS_SHAPE(roots);
+
+        root = NIL_NODE;
+        for (int r = 0; r <= maxRank; r++) {
+            NodeId x = rankTable[r];
+            if (x == NIL_NODE) continue;
+            rankTable[r] = NIL_NODE;
+            root = root == NIL_NODE ? x : link(x, root);
+        }
+        opCount++;
+        return true;
+    }
+
+    void decreaseKey(T value, int newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
+        if (nodeMapping.empty() || value < 0 || value >= (int)nodeMapping.size()) return;
+        NodeId u = nodeMapping[value];
+        if (u == NIL_NODE) return;
+        if (newKey >= pool[u].key) return;
+        opCount++;
+        if (u == root) {
+            pool[u].key = newKey;
+            return;
+        }
+        NodeId v = makeNode(newKey, value);  // may grow the pool: no Node& held across it
+        pool[u].hollow = true;
+        int r = pool[u].rank - 2;
+        pool[v].rank = r > 0 ? r : 0;
+        pool[v].child = u;
+        pool[u].ep = v;
+        root = link(v, root);
+    }
+
+    bool isEmpty() const override { return root == NIL_NODE; }
+    long getOperationCount() const override { return opCount; }
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef LAZY_HEAP_H
+#define LAZY_HEAP_H
+
+#include "PriorityQueue.h"
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+using std::vector;
+using std::pair;
+
+// insert-only heaps for the lazy algorithm mode (runDijkstraLazy / runPrimLazy):
+// no decreaseKey, so no value -> slot map and no capacity bound; a vertex whose key
+// drops is simply inserted again and the stale entry is skipped when it comes out.
+// not PriorityQueue subclasses (that interface requires decreaseKey): static dispatch only.
+// K: key type as in PriorityQueue.h; PackedLazyHeap (PackedHeap.h) packs int keys.
+
+// implicit 4-ary min-heap over one growable array of (key, value) entries. sifts
+// move a hole instead of swapping, so each level costs one entry write.
+template <typename T, typename K = int>
+class QuadLazyHeap final {
+private:
+    struct Entry {
+        K key;
+        T value;
+    };
+
+    vector<Entry> heap;
+    long opCount;
+
+    void siftUp(int i, Entry e) {
+        while (i > 0) {
+            int parent = (i - 1) / 4;
+            if (heap[parent].key <= e.key) break;
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = e;
+    }
+
+    void siftDown(int i, Entry e) {
+        int n = (int)heap.size();
+        while (true) {
+            int first = 4 * i + 1;
+            if (first >= n) break;
+            int last = first + 4 < n ? first + 4 : n;
+            int c = first;
+            for (int j = first + 1; j < last; j++)
+                if (heap[j].key < heap[c].key) c = j;
+            if (heap[c].key >= e.key) break;
+            heap[i] = heap[c];
+            i = c;
+        }
+        heap[i] = e;
+    }
+
+public:
+    // maxVertices only sizes the initial reservation; the heap grows past it
+    explicit QuadLazyHeap(int maxVertices) : opCount(0) { heap.reserve(maxVertices); }
+
+    void insert(K key, T value) {
+        heap.push_back({ key, value });
+        siftUp((int)heap.size() - 1, heap.back());
+        opCount++;
+    }
+
+    bool extractMin(K &outKey, T &outValue) {
+        if (heap.empty()) return false;
+        outKey = heap[0].key;
+        outValue = heap[0].value;
+        Entry last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) siftDown(0, last);
+        opCount++;
+        return true;
+    }
+
+    bool isEmpty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    long getOperationCount() const { return opCount; }
+};
+
+// std::priority_queue (binary heap via push_heap/pop_heap) on (key, value) pairs;
+// the baseline a lazy dijkstra is usually written against
+template <typename T, typename K = int>
+class StdLazyHeap final {
+private:
+    typedef pair<K, T> Entry;
+    std::priority_queue<Entry, vector<Entry>, std::greater<Entry>> heap;
+    long opCount;
+
+public:
+    explicit StdLazyHeap(int maxVertices) : opCount(0) {
+        vector<Entry> storage;
+        storage.reserve(maxVertices);
+        heap = decltype(heap)(std::greater<Entry>(), std::move(storage));
+    }
+
+    void insert(K key, T value) {
+        heap.push({ key, value });
+        opCount++;
+    }
+
+    bool extractMin(K &outKey, T &outValue) {
+        if (heap.empty()) return false;
+        outKey = heap.top().first;
+        outValue = heap.top().second;
+        heap.pop();
+        opCount++;
+        return true;
+    }
+
+    bool isEmpty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    long getOperationCount() const { return opCount; }
+};
+
+#endif
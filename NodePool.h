@@ -0,0 +1,47 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <vector>
+#include <cstdint>
+using std::vector;
+
+// 32-bit node handle; NIL_NODE plays the role of nullptr
+typedef uint32_t NodeId;
+const NodeId NIL_NODE = 0xFFFFFFFFu;
+
+// slab of heap nodes addressed by index instead of pointer.
+// capacity is reserved up front (heaps pass maxVertices), released slots go on a
+// freelist and are handed out again, so steady-state insert/extractMin never
+// touch malloc. growing past the reservation is allowed: indices stay valid.
+template <typename Node>
+class NodePool {
+public:
+    explicit NodePool(int capacity = 0) {
+        nodes.reserve(capacity);
+        freeSlots.reserve(capacity);
+    }
+
+    NodeId allocate() {
+        if (!freeSlots.empty()) {
+            NodeId id = freeSlots.back();
+            freeSlots.pop_back();
+            return id;
+        }
+        nodes.emplace_back();
+        return (NodeId)(nodes.size() - 1);
+    }
+
+    void release(NodeId id) { freeSlots.push_back(id); }
+
+    Node& operator[](NodeId id) { return nodes[id]; }
+    const Node& operator[](NodeId id) const { return nodes[id]; }
+
+    // nodes currently handed out
+    size_t liveCount() const { return nodes.size() - freeSlots.size(); }
+
+private:
+    vector<Node> nodes;
+    vector<NodeId> freeSlots;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef PACKED_HEAP_H
+#define PACKED_HEAP_H
+
+#include "PriorityQueue.h"
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+using std::vector;
+
+// packed heap entries: an int key and a 32-bit vertex id in one 64-bit word, the key
+// (sign bit flipped, so signed order becomes unsigned order) in the high half and the
+// value in the low half. one unsigned compare orders by key, ties by vertex id, and
+// min-child scans compile to conditional moves instead of branches. int keys only:
+// 64-bit distances (K = long long in BinaryHeap / DaryHeap) do not fit beside an id.
+template <typename T>
+struct PackedEntry {
+    static_assert(std::is_integral<T>::value && sizeof(T) <= 4, "packed heaps need a 32-bit integer value");
+
+    // above every real entry (value 0xFFFFFFFF is never a vertex id)
+    static constexpr uint64_t EMPTY = ~(uint64_t)0;
+
+    static uint64_t pack(int key, T value) {
+        return ((uint64_t)((uint32_t)key ^ 0x80000000u) << 32) | (uint32_t)value;
+    }
+    static int key(uint64_t e) { return (int)((uint32_t)(e >> 32) ^ 0x80000000u); }
+    static T value(uint64_t e) { return (T)(uint32_t)e; }
+
+    // index (0..n-1) of the smallest of n entries, branch-free
+    template <int N>
+    static int minOf(const uint64_t* group) {
+        int best = 0;
+        uint64_t m = group[0];
+        for (int j = 1; j < N; j++) {
+            bool lt = group[j] < m;
+            m = lt ? group[j] : m;
+            best = lt ? j : best;
+        }
+        return best;
+    }
+};
+
+// d-ary heap of packed entries with a position map for decreaseKey (same layout
+// rules as DaryHeap: slots[1] 64-byte aligned, padding slots hold EMPTY so a child
+// group is always scanned whole). 8 bytes per slot in one array, where DaryHeap
+// keeps keys and values apart (a second miss for the value) and BinaryHeap an
+// 8-byte pair compared on the key alone.
+template <typename T, int D>
+class PackedDaryHeap final : public PriorityQueue<T> {
+    static_assert(D >= 2 && D <= 16, "PackedDaryHeap arity must be 2..16");
+    typedef PackedEntry<T> Entry;
+
+private:
+    vector<uint64_t> store;  // backing storage, over-allocated for alignment
+    uint64_t* slots;         // logical index i -> slots[i]
+    vector<int> position;    // value -> index, -1 if not in heap
+    int size;
+    long opCount;
+
+    void place(int i, uint64_t e) {
+        HEAP_STATS_MOVE(1);
+        slots[i] = e;
+        position[Entry::value(e)] = i;
+    }
+
+    void bubbleUp(int i) {
+        uint64_t e = slots[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            HEAP_STATS_COMPARE(1);
+            if (slots[parent] <= e) break;
+            place(i, slots[parent]);
+            i = parent;
+        }
+        place(i, e);
+    }
+
+    void bubbleDown(int i) {
+        uint64_t e = slots[i];
+        while (true) {
+            int first = D * i + 1;
+            if (first >= size) break;
+            HEAP_STATS_COMPARE(D);
+            int c = first + Entry::template minOf<D>(slots + first);
+            if (slots[c] >= e) break;
+            place(i, slots[c]);
+            i = c;
+        }
+        place(i, e);
+    }
+
+public:
+    explicit PackedDaryHeap(int maxVertices) : size(0), opCount(0) {
+        // maxVertices + one padding group + 64 bytes of alignment slack
+        store.assign((size_t)maxVertices + D + 8, Entry::EMPTY);
+        uintptr_t base = (uintptr_t)(store.data() + 1);
+        uintptr_t aligned = (base + 63) & ~(uintptr_t)63;
+        slots = (uint64_t*)aligned - 1;
+        position.assign(maxVertices, -1);
+    }
+
+    // slots points into store
+    PackedDaryHeap(const PackedDaryHeap&) = delete;
+    PackedDaryHeap& operator=(const PackedDaryHeap&) = delete;
+
+    void insert(int key, T value) override {
+        HEAP_STATS_OP(HEAP_INSERT);
+        int i = size++;
+        slots[i] = Entry::pack(key, value);
+        bubbleUp(i);
+        opCount++;
+    }
+
+    bool extractMin(int &outKey, T &outValue) override {
+        if (size == 0) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        HEAP_STATS_SHAPE(heapDepth(size, D));
+        outKey = Entry::key(slots[0]);
+        outValue = Entry::value(slots[0]);
+        position[outValue] = -1;
+        size--;
+        if (size > 0) {
+            slots[0] = slots[size];
+            slots[size] = Entry::EMPTY;
+            bubbleDown(0);
+        } else {
+            slots[0] = Entry::EMPTY;
+        }
+        opCount++;
+        return true;
+    }
+
+    void decreaseKey(T value, int newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
+        int i = position[value];
+        if (i < 0) return;
+        uint64_t e = Entry::pack(newKey, value);
+        if (e >= slots[i]) return;
+        slots[i] = e;
+        bubbleUp(i);
+        opCount++;
+    }
+
+    bool isEmpty() const override { return size == 0; }
+    long getOperationCount() const override { return opCount; }
+};
+
+// single-parameter names for the benchmark's heap table
+template <typename T> using PackedBinaryHeap = PackedDaryHeap<T, 2>;
+template <typename T> using PackedDaryHeap4 = PackedDaryHeap<T, 4>;
+template <typename T> using PackedDaryHeap8 = PackedDaryHeap<T, 8>;
+
+// insert-only 4-ary heap of packed entries for the lazy algorithms (QuadLazyHeap in
+// LazyHeap.h, packed): no position map, grows past maxVertices. the array always
+// holds a padding group of EMPTY past the end, so min-child scans have no bound checks.
+template <typename T>
+class PackedLazyHeap final {
+    typedef PackedEntry<T> Entry;
+
+private:
+    vector<uint64_t> slots;
+    int count;
+    long opCount;
+
+public:
+    explicit PackedLazyHeap(int maxVertices) : slots((size_t)maxVertices + 4, Entry::EMPTY), count(0), opCount(0) {}
+
+    void insert(int key, T value) {
+        if ((size_t)count + 4 >= slots.size()) slots.resize(2 * slots.size(), Entry::EMPTY);
+        uint64_t e = Entry::pack(key, value);
+        int i = count++;
+        while (i > 0) {
+            int parent = (i - 1) / 4;
+            if (slots[parent] <= e) break;
+            slots[i] = slots[parent];
+            i = parent;
+        }
+        slots[i] = e;
+        opCount++;
+    }
+
+    bool extractMin(int &outKey, T &outValue) {
+        if (count == 0) return false;
+        outKey = Entry::key(slots[0]);
+        outValue = Entry::value(slots[0]);
+        count--;
+        uint64_t e = slots[count];
+        slots[count] = Entry::EMPTY;
+        int i = 0;
+        while (count > 0) {
+            int first = 4 * i + 1;
+            if (first >= count) break;
+            int c = first + Entry::template minOf<4>(&slots[first]);
+            if (slots[c] >= e) break;
+            slots[i] = slots[c];
+            i = c;
+        }
+        slots[i] = count > 0 ? e : Entry::EMPTY;
+        opCount++;
+        return true;
+    }
+
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return (size_t)count; }
+    long getOperationCount() const { return opCount; }
+};
+
+#endif
@@ -2,160 +2,264 @@
 #define PAIRING_HEAP_H
 
 #include "PriorityQueue.h"
+#include "NodePool.h"
 #include <vector>
 #include <unordered_set>
+#ifdef PAIRING_HEAP_DEBUG
+#include <cassert>
+#endif
 using std::vector;
 using std::unordered_set;
 
-template <typename T>
-class PairingHeap : public PriorityQueue<T> {
+// how extractMin combines the root's children
+//   TwoPass    - pair left to right, then merge right to left (classic)
+//   Multipass  - keep pairing front two and appending to the back until one tree remains
+//   AuxTwoPass - inserts and cut subtrees go to an auxiliary root list that is combined
+//                (multipass) and linked to the root only at extractMin (Stasko-Vitter)
+enum class PairingVariant { TwoPass, Multipass, AuxTwoPass };
+
+// all passes run in place over the sibling links, so steady-state extractMin
+// allocates nothing. define PAIRING_HEAP_DEBUG for sibling-list cycle checks.
+template <typename T, PairingVariant V>
+class BasicPairingHeap final : public PriorityQueue<T> {
 private:
+    // links are pool indices (NIL_NODE = none)
     struct Node {
         int key;
         T value;
         long long seq;  // tie-break by insert order
-        Node* child;
-        Node* sibling;
-        Node* prev;
-        Node(int k, T v, long long s) : key(k), value(v), seq(s), child(nullptr), sibling(nullptr), prev(nullptr) {}
+        NodeId child;
+        NodeId sibling;
+        NodeId prev;    // parent if first child, else left sibling; NIL for roots
     };
 
-    Node* root;
-    vector<Node*> nodeMapping;
+    NodePool<Node> pool;
+    NodeId root;
+    NodeId auxHead;  // AuxTwoPass only: pending roots linked through sibling
+    vector<NodeId> nodeMapping;
     long opCount;
     long long nextSeq;
 
-    Node* merge(Node* A, Node* B) {
-        if (!A) return B;
-        if (!B) return A;
-        if (A == B) return A;
+    NodeId merge(NodeId a, NodeId b) {
+        if (a == NIL_NODE) return b;
+        if (b == NIL_NODE) return a;
+        if (a == b) return a;
+        Node& A = pool[a];
+        Node& B = pool[b];
+        HEAP_STATS_COMPARE(1);
+        HEAP_STATS_MOVE(1);
         // smaller key wins; tie = smaller seq first
-        bool A_smaller = (A->key < B->key) || (A->key == B->key && A->seq < B->seq);
+        bool A_smaller = (A.key < B.key) || (A.key == B.key && A.seq < B.seq);
         if (A_smaller) {
-            B->sibling = A->child;
-            if (A->child) A->child->prev = B;
-            A->child = B;
-            B->prev = A;
-            return A;
+            B.sibling = A.child;
+            if (A.child != NIL_NODE) pool[A.child].prev = b;
+            A.child = b;
+            B.prev = a;
+            return a;
         } else {
-            A->sibling = B->child;
-            if (B->child) B->child->prev = A;
-            B->child = A;
-            A->prev = B;
-            return B;
+            A.sibling = B.child;
+            if (B.child != NIL_NODE) pool[B.child].prev = a;
+            B.child = a;
+            A.prev = b;
+            return b;
         }
     }
 
-    // two-pass merge of sibling list (collect, clear links, pair merge then merge right-to-left)
-    Node* twoPassMerge(Node* firstSibling) {
-        if (!firstSibling) return nullptr;
-        if (!firstSibling->sibling) return firstSibling;
+    size_t listLength(NodeId first) const {
+        size_t len = 0;
+        for (NodeId p = first; p != NIL_NODE; p = pool[p].sibling) len++;
+        return len;
+    }
 
-        vector<Node*> nodes;
-        unordered_set<Node*> seen;
-        const size_t maxNodes = 1u << 20;
-        for (Node* p = firstSibling; p && nodes.size() < maxNodes; p = p->sibling) {
-            if (seen.count(p)) break;
-            seen.insert(p);
-            nodes.push_back(p);
+#ifdef PAIRING_HEAP_DEBUG
+    // floyd's cycle check over a sibling list (no allocation)
+    void checkSiblingList(NodeId first) const {
+        NodeId slow = first, fast = first;
+        while (fast != NIL_NODE && pool[fast].sibling != NIL_NODE) {
+            slow = pool[slow].sibling;
+            fast = pool[pool[fast].sibling].sibling;
+            assert(slow != fast && "PairingHeap: cycle in sibling list");
         }
-        for (Node* p : nodes)
-            p->sibling = nullptr;
-
-        vector<Node*> pass1;
-        for (size_t i = 0; i < nodes.size(); i += 2) {
-            if (i + 1 < nodes.size())
-                pass1.push_back(merge(nodes[i], nodes[i + 1]));
-            else
-                pass1.push_back(nodes[i]);
+    }
+#endif
+
+    // pass 1 pairs left to right and pushes each winner onto a stack threaded
+    // through sibling; pass 2 pops (rightmost first) and merges into the result
+    NodeId twoPassMerge(NodeId first) {
+        if (first == NIL_NODE) return NIL_NODE;
+        if (pool[first].sibling == NIL_NODE) return first;
+
+        NodeId stack = NIL_NODE;
+        NodeId a = first;
+        while (a != NIL_NODE) {
+            NodeId b = pool[a].sibling;
+            if (b == NIL_NODE) {
+                pool[a].sibling = stack;
+                stack = a;
+                break;
+            }
+            NodeId next = pool[b].sibling;
+            pool[a].sibling = NIL_NODE;
+            pool[b].sibling = NIL_NODE;
+            NodeId m = merge(a, b);
+            pool[m].sibling = stack;
+            stack = m;
+            a = next;
         }
 
-        Node* result = pass1.back();
-        for (int i = (int)pass1.size() - 2; i >= 0; --i)
-            result = merge(pass1[i], result);
+        NodeId result = stack;
+        stack = pool[stack].sibling;
+        pool[result].sibling = NIL_NODE;
+        while (stack != NIL_NODE) {
+            NodeId next = pool[stack].sibling;
+            pool[stack].sibling = NIL_NODE;
+            result = merge(stack, result);
+            stack = next;
+        }
         return result;
     }
 
+    // sibling list used as a fifo: merge the front two, append the winner at the back
+    NodeId multipassMerge(NodeId first) {
+        if (first == NIL_NODE) return NIL_NODE;
+        NodeId tail = first;
+        while (pool[tail].sibling != NIL_NODE) tail = pool[tail].sibling;
+
+        NodeId head = first;
+        while (head != tail) {
+            NodeId a = head;
+            NodeId b = pool[a].sibling;
+            head = pool[b].sibling;
+            pool[a].sibling = NIL_NODE;
+            pool[b].sibling = NIL_NODE;
+            NodeId m = merge(a, b);
+            if (head == NIL_NODE) return m;  // b was the tail
+            pool[tail].sibling = m;
+            tail = m;
+        }
+        return head;
+    }
+
+    NodeId combine(NodeId first) {
+#ifdef PAIRING_HEAP_DEBUG
+        checkSiblingList(first);
+#endif
+        if constexpr (V == PairingVariant::Multipass)
+            return multipassMerge(first);
+        else
+            return twoPassMerge(first);
+    }
+
+    // new or cut subtree (prev/sibling already NIL) joins the heap
+    void addRoot(NodeId id) {
+        if constexpr (V == PairingVariant::AuxTwoPass) {
+            pool[id].sibling = auxHead;
+            auxHead = id;
+        } else {
+            root = merge(root, id);
+            pool[root].prev = NIL_NODE;
+        }
+    }
+
 public:
-    PairingHeap() : root(nullptr), opCount(0), nextSeq(0) {}
-    explicit PairingHeap(int maxVertices) : root(nullptr), opCount(0), nextSeq(0) {
-        nodeMapping.resize(maxVertices, nullptr);
+    BasicPairingHeap() : root(NIL_NODE), auxHead(NIL_NODE), opCount(0), nextSeq(0) {}
+    explicit BasicPairingHeap(int maxVertices)
+        : pool(maxVertices), root(NIL_NODE), auxHead(NIL_NODE), opCount(0), nextSeq(0) {
+        nodeMapping.resize(maxVertices, NIL_NODE);
     }
 
     void insert(int key, T value) override {
-        Node* newNode = new Node(key, value, nextSeq++);
+        HEAP_STATS_OP(HEAP_INSERT);
+        NodeId id = pool.allocate();
+        Node& node = pool[id];
+        node.key = key;
+        node.value = value;
+        node.seq = nextSeq++;
+        node.child = node.sibling = node.prev = NIL_NODE;
         if (value >= 0 && value < (int)nodeMapping.size())
-            nodeMapping[value] = newNode;
-        root = merge(root, newNode);
-        if (root) root->prev = nullptr;
+            nodeMapping[value] = id;
+        addRoot(id);
         opCount++;
     }
 
     bool extractMin(int &outKey, T &outValue) override {
-        if (!root) return false;
-        outKey = root->key;
-        outValue = root->value;
-        if (outValue >= 0 && outValue < (int)nodeMapping.size())
-            nodeMapping[outValue] = nullptr;
-
-        Node* oldRoot = root;
-        Node* first = root->child;
-        if (first) {
-            Node* last = first;
-            while (last->sibling) last = last->sibling;
-            last->sibling = root->sibling;
-        } else {
-            first = root->sibling;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        // roots combined: pending aux roots, then the root's children
+        HEAP_STATS_SHAPE(listLength(auxHead) + listLength(root == NIL_NODE ? NIL_NODE : pool[root].child));
+        if constexpr (V == PairingVariant::AuxTwoPass) {
+            if (auxHead != NIL_NODE) {
+                // aux roots have prev == NIL already; link the combined tree under/over root
+                root = merge(root, multipassMerge(auxHead));
+                auxHead = NIL_NODE;
+                pool[root].prev = NIL_NODE;
+            }
         }
-        root = first ? twoPassMerge(first) : nullptr;
-        if (root) root->prev = nullptr;
-        delete oldRoot;
+        if (root == NIL_NODE) return false;
+        Node& r = pool[root];
+        outKey = r.key;
+        outValue = r.value;
+        if (outValue >= 0 && outValue < (int)nodeMapping.size())
+            nodeMapping[outValue] = NIL_NODE;
+
+        // the root never has siblings, so its child list is the whole forest
+        NodeId oldRoot = root;
+        root = combine(r.child);
+        if (root != NIL_NODE) pool[root].prev = NIL_NODE;
+        pool.release(oldRoot);
         opCount++;
         return true;
     }
 
     void decreaseKey(T value, int newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
         if (value < 0 || value >= (int)nodeMapping.size()) return;
-        Node* node = nodeMapping[value];
-        if (!node) return;
-        if (newKey >= node->key) return;
-
-        node->key = newKey;
-        Node* parent = node->prev;
-        if (!parent) return;
-        if (newKey >= parent->key) return;
+        NodeId id = nodeMapping[value];
+        if (id == NIL_NODE) return;
+        Node& node = pool[id];
+        if (newKey >= node.key) return;
+
+        node.key = newKey;
+        NodeId parent = node.prev;
+        if (parent == NIL_NODE) return;
+        HEAP_STATS_COMPARE(1);
+        if (newKey >= pool[parent].key) return;
+        HEAP_STATS_MOVE(1);
         // unlink node from parent's child list
-        if (parent->child == node)
-            parent->child = node->sibling;
+        if (pool[parent].child == id)
+            pool[parent].child = node.sibling;
         else
-            node->prev->sibling = node->sibling;
-        if (node->sibling)
-            node->sibling->prev = node->prev;
-        node->sibling = nullptr;
-        node->prev = nullptr;
-
-        root = merge(node, root);
-        if (root) root->prev = nullptr;
+            pool[node.prev].sibling = node.sibling;
+        if (node.sibling != NIL_NODE)
+            pool[node.sibling].prev = node.prev;
+        node.sibling = NIL_NODE;
+        node.prev = NIL_NODE;
+
+        addRoot(id);
         opCount++;
     }
 
-    bool isEmpty() const override { return root == nullptr; }
+    bool isEmpty() const override { return root == NIL_NODE && auxHead == NIL_NODE; }
     long getOperationCount() const override { return opCount; }
 
     size_t countNodes() const {
-        unordered_set<Node*> seen;
-        vector<Node*> stack;
-        if (root) stack.push_back(root);
+        unordered_set<NodeId> seen;
+        vector<NodeId> stack;
+        if (root != NIL_NODE) stack.push_back(root);
+        if (auxHead != NIL_NODE) stack.push_back(auxHead);
         while (!stack.empty()) {
-            Node* p = stack.back();
+            NodeId p = stack.back();
             stack.pop_back();
-            if (!p || seen.count(p)) continue;
+            if (p == NIL_NODE || seen.count(p)) continue;
             seen.insert(p);
-            if (p->child) stack.push_back(p->child);
-            if (p->sibling) stack.push_back(p->sibling);
+            if (pool[p].child != NIL_NODE) stack.push_back(pool[p].child);
+            if (pool[p].sibling != NIL_NODE) stack.push_back(pool[p].sibling);
         }
         return seen.size();
     }
 };
 
+template <typename T> using PairingHeap = BasicPairingHeap<T, PairingVariant::TwoPass>;
+template <typename T> using MultipassPairingHeap = BasicPairingHeap<T, PairingVariant::Multipass>;
+template <typename T> using AuxPairingHeap = BasicPairingHeap<T, PairingVariant::AuxTwoPass>;
+
 #endif
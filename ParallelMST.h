@@ -0,0 +1,230 @@
+#ifndef PARALLEL_MST_H
+#define PARALLEL_MST_H
+
+#include "Graph.h"
+#include "ThreadPool.h"
+#include "UnionFind.h"
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+using std::vector;
+
+// heap-free MST engines. both return the same totalWeight as Algorithms::runPrim
+// from startNode: the spanning forest is built for the whole graph and only the
+// tree containing startNode is summed. graphs are undirected (each edge stored
+// in both endpoints' lists); the u < v copy is used.
+class ParallelMST {
+public:
+    // boruvka with union-find contraction: every round each component picks its
+    // lightest outgoing edge (atomic min on weight:edgeIndex, so ties never form a
+    // cycle), the picks are united, endpoints are relabelled to their set roots and
+    // self-loops are dropped in parallel
+    template <typename GraphT>
+    static void runBoruvka(const GraphT& g, int startNode, ThreadPool& pool, int& totalWeight) {
+        int n = g.numVertices;
+        vector<WeightedEdge> edges = edgeList(g, pool);
+        UnionFind uf(n);
+        vector<int> root(n);
+        vector<WeightedEdge> forest;
+        const uint64_t NONE = ~(uint64_t)0;
+        std::unique_ptr<std::atomic<uint64_t>[]> best(new std::atomic<uint64_t>[n]);
+        for (int v = 0; v < n; v++) best[v].store(NONE, std::memory_order_relaxed);
+
+        while (!edges.empty()) {
+            int chunks = numChunks(edges.size());
+            pool.parallelFor(chunks, [&](int, int c) {
+                size_t end = std::min(edges.size(), (size_t)(c + 1) * CHUNK);
+                for (size_t i = (size_t)c * CHUNK; i < end; i++) {
+                    uint64_t key = ((uint64_t)(uint32_t)edges[i].weight << 32) | (uint64_t)i;
+                    atomicMin(best[edges[i].u], key);
+                    atomicMin(best[edges[i].v], key);
+                }
+            });
+
+            for (int c = 0; c < n; c++) {
+                uint64_t key = best[c].load(std::memory_order_relaxed);
+                if (key == NONE) continue;
+                best[c].store(NONE, std::memory_order_relaxed);
+                const WeightedEdge& e = edges[(size_t)(key & 0xFFFFFFFFu)];
+                if (uf.unite(e.u, e.v))
+                    forest.push_back(e);
+            }
+
+            // contract: endpoints -> set roots, drop edges now inside one component
+            flattenRoots(uf, root);
+            vector<WeightedEdge> next;
+            parallelPartition(edges, pool, next, nullptr, [&](WeightedEdge& e) {
+                e.u = root[e.u];
+                e.v = root[e.v];
+                return e.u != e.v;
+            });
+            edges.swap(next);
+        }
+        totalWeight = componentWeight(forest, uf, startNode);
+    }
+
+    // filter-kruskal (osipov, sanders, singler): split edges around a pivot weight
+    // with a parallel partition, solve the light half, drop heavy edges whose
+    // endpoints are already connected, then solve the rest. small inputs are
+    // sorted (in parallel when large enough) and run through plain kruskal.
+    template <typename GraphT>
+    static void runFilterKruskal(const GraphT& g, int startNode, ThreadPool& pool, int& totalWeight) {
+        int n = g.numVertices;
+        vector<WeightedEdge> edges = edgeList(g, pool);
+        UnionFind uf(n);
+        vector<WeightedEdge> forest;
+        filterKruskal(edges, uf, pool, forest);
+        totalWeight = componentWeight(forest, uf, startNode);
+    }
+
+private:
+    static constexpr size_t CHUNK = 4096;
+    static constexpr size_t KRUSKAL_THRESHOLD = 1 << 14;
+    static constexpr size_t PARALLEL_SORT_THRESHOLD = 1 << 16;
+
+    // root[v] = set of v, so parallel phases look roots up instead of walking parent chains
+    static void flattenRoots(UnionFind& uf, vector<int>& root) {
+        for (int v = 0; v < (int)root.size(); v++)
+            root[v] = uf.find(v);
+    }
+
+    static int numChunks(size_t count) { return (int)((count + CHUNK - 1) / CHUNK); }
+
+    static void atomicMin(std::atomic<uint64_t>& a, uint64_t v) {
+        uint64_t cur = a.load(std::memory_order_relaxed);
+        while (v < cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+
+    // u < v copy of every undirected edge, in vertex order
+    template <typename GraphT>
+    static vector<WeightedEdge> edgeList(const GraphT& g, ThreadPool& pool) {
+        int n = g.numVertices;
+        const int VERTS = 1024;
+        int chunks = (n + VERTS - 1) / VERTS;
+        vector<vector<WeightedEdge>> parts(chunks);
+        pool.parallelFor(chunks, [&](int, int c) {
+            int end = std::min(n, (c + 1) * VERTS);
+            for (int u = c * VERTS; u < end; u++)
+                for (const auto& edge : g.neighbors(u))
+                    if (u < edge.target)
+                        parts[c].push_back({ u, edge.target, edge.weight });
+        });
+        return concat(parts);
+    }
+
+    static vector<WeightedEdge> concat(vector<vector<WeightedEdge>>& parts) {
+        size_t total = 0;
+        for (const auto& p : parts) total += p.size();
+        vector<WeightedEdge> out;
+        out.reserve(total);
+        for (auto& p : parts) {
+            out.insert(out.end(), p.begin(), p.end());
+            vector<WeightedEdge>().swap(p);
+        }
+        return out;
+    }
+
+    // order-preserving parallel partition; pred may rewrite the edge.
+    // edges with pred true go to yes, the rest to no (dropped if no is null)
+    template <typename Pred>
+    static void parallelPartition(vector<WeightedEdge>& in, ThreadPool& pool,
+                                  vector<WeightedEdge>& yes, vector<WeightedEdge>* no, Pred pred) {
+        int chunks = numChunks(in.size());
+        vector<vector<WeightedEdge>> yesParts(chunks), noParts(no ? chunks : 0);
+        pool.parallelFor(chunks, [&](int, int c) {
+            size_t end = std::min(in.size(), (size_t)(c + 1) * CHUNK);
+            yesParts[c].reserve(end - (size_t)c * CHUNK);
+            if (no) noParts[c].reserve(end - (size_t)c * CHUNK);
+            for (size_t i = (size_t)c * CHUNK; i < end; i++) {
+                WeightedEdge e = in[i];
+                if (pred(e)) yesParts[c].push_back(e);
+                else if (no) noParts[c].push_back(e);
+            }
+        });
+        yes = concat(yesParts);
+        if (no) *no = concat(noParts);
+    }
+
+    static bool lighter(const WeightedEdge& a, const WeightedEdge& b) { return a.weight < b.weight; }
+
+    // sort chunks in parallel, then merge neighbouring runs pairwise in parallel rounds
+    static void parallelSort(vector<WeightedEdge>& edges, ThreadPool& pool) {
+        int parts = pool.size();
+        if (edges.size() < PARALLEL_SORT_THRESHOLD || parts == 1) {
+            std::sort(edges.begin(), edges.end(), lighter);
+            return;
+        }
+        vector<size_t> bounds(parts + 1);
+        for (int i = 0; i <= parts; i++)
+            bounds[i] = edges.size() * i / parts;
+        pool.parallelFor(parts, [&](int, int i) {
+            std::sort(edges.begin() + bounds[i], edges.begin() + bounds[i + 1], lighter);
+        });
+        for (int width = 1; width < parts; width *= 2) {
+            int merges = (parts + 2 * width - 1) / (2 * width);
+            pool.parallelFor(merges, [&](int, int m) {
+                int lo = m * 2 * width;
+                int mid = std::min(parts, lo + width);
+                int hi = std::min(parts, lo + 2 * width);
+                if (mid < hi)
+                    std::inplace_merge(edges.begin() + bounds[lo], edges.begin() + bounds[mid],
+                                       edges.begin() + bounds[hi], lighter);
+            });
+        }
+    }
+
+    static void kruskal(vector<WeightedEdge>& edges, UnionFind& uf, ThreadPool& pool,
+                        vector<WeightedEdge>& forest) {
+        parallelSort(edges, pool);
+        for (const WeightedEdge& e : edges)
+            if (uf.unite(e.u, e.v))
+                forest.push_back(e);
+    }
+
+    static void filterKruskal(vector<WeightedEdge>& edges, UnionFind& uf, ThreadPool& pool,
+                              vector<WeightedEdge>& forest) {
+        if (edges.size() <= KRUSKAL_THRESHOLD) {
+            kruskal(edges, uf, pool, forest);
+            return;
+        }
+        // pivot = median weight of an evenly spaced sample
+        vector<int> sample;
+        for (size_t i = 0; i < 63; i++)
+            sample.push_back(edges[i * (edges.size() - 1) / 62].weight);
+        std::nth_element(sample.begin(), sample.begin() + 31, sample.end());
+        int pivot = sample[31];
+
+        vector<WeightedEdge> light, heavy;
+        parallelPartition(edges, pool, light, &heavy, [&](WeightedEdge& e) { return e.weight <= pivot; });
+        if (heavy.empty()) {
+            // pivot is the max weight, partition cannot shrink the problem
+            kruskal(edges, uf, pool, forest);
+            return;
+        }
+        vector<WeightedEdge>().swap(edges);
+        filterKruskal(light, uf, pool, forest);
+        vector<WeightedEdge>().swap(light);
+
+        vector<int> root(uf.numElements());
+        flattenRoots(uf, root);
+        vector<WeightedEdge> remaining;
+        parallelPartition(heavy, pool, remaining, nullptr, [&](WeightedEdge& e) {
+            return root[e.u] != root[e.v];
+        });
+        vector<WeightedEdge>().swap(heavy);
+        filterKruskal(remaining, uf, pool, forest);
+    }
+
+    static int componentWeight(const vector<WeightedEdge>& forest, UnionFind& uf, int startNode) {
+        long long total = 0;
+        int root = uf.find(startNode);
+        for (const WeightedEdge& e : forest)
+            if (uf.find(e.u) == root)
+                total += e.weight;
+        return (int)total;
+    }
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// hardware counters of the calling thread (user mode only) around a region, via
+// linux perf_event_open. events are opened one by one rather than as a group, so a
+// cpu or vm that lacks one event still reports the rest; events the kernel
+// multiplexes are scaled by enabled/running time. on other platforms, or when
+// perf_event_paranoid / the hypervisor denies every event, available() is false,
+// start/stop do nothing and callers report wall time only.
+class PerfCounters {
+public:
+    enum Event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES, NUM_EVENTS };
+
+    struct Reading {
+        uint64_t value[NUM_EVENTS];
+        bool valid[NUM_EVENTS];
+    };
+
+    PerfCounters() {
+        for (int e = 0; e < NUM_EVENTS; e++) fds[e] = -1;
+#if defined(__linux__)
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = eventType(e);
+            attr.config = eventConfig(e);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int e = 0; e < NUM_EVENTS; e++)
+            if (fds[e] >= 0) close(fds[e]);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool has(int e) const { return fds[e] >= 0; }
+
+    bool available() const {
+        for (int e = 0; e < NUM_EVENTS; e++)
+            if (has(e)) return true;
+        return false;
+    }
+
+    void start() {
+#if defined(__linux__)
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            if (!has(e)) continue;
+            ioctl(fds[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    Reading stop() {
+        Reading r;
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            r.value[e] = 0;
+            r.valid[e] = false;
+        }
+#if defined(__linux__)
+        for (int e = 0; e < NUM_EVENTS; e++)
+            if (has(e)) ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            uint64_t buf[3];  // value, time enabled, time running
+            if (!has(e) || read(fds[e], buf, sizeof(buf)) != (ssize_t)sizeof(buf)) continue;
+            if (buf[2] == 0) continue;  // never scheduled on the pmu
+            r.value[e] = buf[2] < buf[1] ? (uint64_t)((double)buf[0] * buf[1] / buf[2]) : buf[0];
+            r.valid[e] = true;
+        }
+#endif
+        return r;
+    }
+
+    // csv column names, in Event order
+    static const char* name(int e) {
+        static const char* const names[] = { "Cycles", "Instructions", "L1DMisses", "LLCMisses",
+                                             "BranchMisses", "DTLBMisses" };
+        return names[e];
+    }
+
+private:
+    int fds[NUM_EVENTS];
+
+#if defined(__linux__)
+    static uint32_t eventType(int e) {
+        return e == L1D_MISSES || e == LLC_MISSES || e == DTLB_MISSES ? PERF_TYPE_HW_CACHE : PERF_TYPE_HARDWARE;
+    }
+
+    static uint64_t cacheReadMiss(uint64_t cache) {
+        return cache | ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) | ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    static uint64_t eventConfig(int e) {
+        switch (e) {
+        case CYCLES: return PERF_COUNT_HW_CPU_CYCLES;
+        case INSTRUCTIONS: return PERF_COUNT_HW_INSTRUCTIONS;
+        case L1D_MISSES: return cacheReadMiss(PERF_COUNT_HW_CACHE_L1D);
+        case LLC_MISSES: return cacheReadMiss(PERF_COUNT_HW_CACHE_LL);
+        case BRANCH_MISSES: return PERF_COUNT_HW_BRANCH_MISSES;
+        default: return cacheReadMiss(PERF_COUNT_HW_CACHE_DTLB);
+        }
+    }
+#endif
+};
+
+#endif
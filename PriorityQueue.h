@@ -1,21 +1,63 @@
 #ifndef PRIORITY_QUEUE_H
 #define PRIORITY_QUEUE_H
 
+#include "HeapStats.h"
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
-// abstract base so dijkstra/prim can take any heap impl
-template <typename T>
+// abstract base so dijkstra/prim can take any heap impl.
+// K: key type, int by default; long long for distances past INT_MAX (BinaryHeap, DaryHeap)
+template <typename T, typename K = int>
 class PriorityQueue {
 public:
     virtual ~PriorityQueue() {}
 
-    virtual void insert(int key, T value) = 0;
+    virtual void insert(K key, T value) = 0;
     // true if extracted, false if empty
-    virtual bool extractMin(int &outKey, T &outValue) = 0;
+    virtual bool extractMin(K &outKey, T &outValue) = 0;
     // need to find node by value (we use vertex id)
-    virtual void decreaseKey(T value, int newKey) = 0;
+    virtual void decreaseKey(T value, K newKey) = 0;
     virtual bool isEmpty() const = 0;
     virtual long getOperationCount() const = 0;
+
+#ifdef HEAP_STATS
+    // per-operation calls, latency, comparisons and moves (HeapStats.h)
+    const HeapStats& getStats() const { return stats; }
+
+protected:
+    HeapStats stats;
+#endif
 };
 
+// static interface check for the template (non-virtual) algorithm overloads:
+// true if PQ has insert(K, T), bool extractMin(K&, T&), decreaseKey(T, K), isEmpty()
+template <typename PQ, typename T, typename K = int, typename = void>
+struct IsPriorityQueue : std::false_type {};
+
+template <typename PQ, typename T, typename K>
+struct IsPriorityQueue<PQ, T, K, std::void_t<
+    decltype(std::declval<PQ&>().insert(std::declval<K>(), std::declval<T>())),
+    decltype(bool(std::declval<PQ&>().extractMin(std::declval<K&>(), std::declval<T&>()))),
+    decltype(std::declval<PQ&>().decreaseKey(std::declval<T>(), std::declval<K>())),
+    decltype(bool(std::declval<const PQ&>().isEmpty()))>> : std::true_type {};
+
+// the lazy-deletion algorithms only insert and extract: any IsPriorityQueue heap
+// plus the insert-only ones (LazyHeap.h)
+template <typename PQ, typename T, typename K = int, typename = void>
+struct IsInsertOnlyQueue : std::false_type {};
+
+template <typename PQ, typename T, typename K>
+struct IsInsertOnlyQueue<PQ, T, K, std::void_t<
+    decltype(std::declval<PQ&>().insert(std::declval<K>(), std::declval<T>())),
+    decltype(bool(std::declval<PQ&>().extractMin(std::declval<K&>(), std::declval<T&>()))),
+    decltype(bool(std::declval<const PQ&>().isEmpty()))>> : std::true_type {};
+
+// true if HeapT has reset() (monotone queues must rewind between queries)
+template <typename HeapT, typename = void>
+struct HasHeapReset : std::false_type {};
+
+template <typename HeapT>
+struct HasHeapReset<HeapT, std::void_t<decltype(std::declval<HeapT&>().reset())>> : std::true_type {};
+
 #endif
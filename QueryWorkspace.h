@@ -0,0 +1,116 @@
+#ifndef QUERY_WORKSPACE_H
+#define QUERY_WORKSPACE_H
+
+#include "PriorityQueue.h"
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+using std::vector;
+
+// per-vertex state of one shortest-path query, kept across queries. every slot
+// carries the epoch of the query that last wrote it and begin() just bumps the
+// epoch, so slots of earlier queries read as untouched (dist unreached, not queued,
+// not settled) without being cleared: a query costs time in the vertices it
+// touches, not in n. slots are only wiped when the 32-bit epoch wraps.
+// HeapT is the concrete heap, built once as HeapT(n); begin() empties it (a query
+// that stopped early leaves entries behind) and resets monotone queues.
+template <typename HeapT>
+class QueryWorkspace {
+public:
+    static constexpr int UNREACHED = std::numeric_limits<int>::max();
+
+    HeapT heap;
+
+    explicit QueryWorkspace(int size)
+        : heap(size), n(size), epoch(0), numSettled(0), slots(size, Slot{ 0, UNREACHED, -1, UNSEEN }) {}
+
+    QueryWorkspace(const QueryWorkspace&) = delete;
+    QueryWorkspace& operator=(const QueryWorkspace&) = delete;
+
+    int numVertices() const { return n; }
+
+    // starts a new query; everything recorded by the previous one is dropped
+    void begin() {
+        if (++epoch == 0) {
+            for (Slot& s : slots) s.epoch = 0;
+            epoch = 1;
+        }
+        touchedList.clear();
+        numSettled = 0;
+        int key, v;
+        while (!heap.isEmpty()) heap.extractMin(key, v);
+        if constexpr (HasHeapReset<HeapT>::value)
+            heap.reset();
+    }
+
+    int dist(int v) const { return current(v) ? slots[v].dist : UNREACHED; }
+    bool queued(int v) const { return current(v) && slots[v].state == QUEUED; }
+    bool settled(int v) const { return current(v) && slots[v].state == SETTLED; }
+    int parent(int v) const { return current(v) ? slots[v].parent : -1; }  // -1: source or unreached
+
+    // dist and the predecessor it came through
+    void setDist(int v, int d, int from) {
+        Slot& s = touch(v);
+        s.dist = d;
+        s.parent = from;
+    }
+    void markQueued(int v) { touch(v).state = QUEUED; }
+    void markSettled(int v) {
+        touch(v).state = SETTLED;
+        numSettled++;
+    }
+
+    int settledCount() const { return numSettled; }
+
+    // source..v along the parents; false (path empty) if v was not reached
+    bool pathTo(int v, vector<int>& path) const {
+        path.clear();
+        if (dist(v) == UNREACHED) return false;
+        for (int u = v; u != -1; u = parent(u))
+            path.push_back(u);
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+
+    // vertices this query wrote, in first-touch order
+    const vector<int>& touched() const { return touchedList; }
+
+    // dist of every vertex into out[0..n) (dense output, e.g. distance matrix rows)
+    void copyDist(int* out) const {
+        for (int v = 0; v < n; v++) out[v] = dist(v);
+    }
+
+private:
+    enum State : int { UNSEEN, QUEUED, SETTLED };
+
+    // one cache line access answers every question about a vertex
+    struct Slot {
+        uint32_t epoch;
+        int dist;
+        int parent;
+        int state;
+    };
+
+    int n;
+    uint32_t epoch;
+    int numSettled;
+    vector<Slot> slots;
+    vector<int> touchedList;
+
+    bool current(int v) const { return slots[v].epoch == epoch; }
+
+    Slot& touch(int v) {
+        Slot& s = slots[v];
+        if (s.epoch != epoch) {
+            s.epoch = epoch;
+            s.dist = UNREACHED;
+            s.parent = -1;
+            s.state = UNSEEN;
+            touchedList.push_back(v);
+        }
+        return s;
+    }
+};
+
+#endif
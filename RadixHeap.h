@@ -0,0 +1,111 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include "PriorityQueue.h"
+#include "BucketLists.h"
+#include <vector>
+#include <stdexcept>
+using std::vector;
+
+// radix heap for monotone non-negative int keys (dijkstra only).
+// bucket 0 holds keys equal to last, bucket i holds keys whose highest bit
+// differing from last is bit i-1. extractMin refills bucket 0 by redistributing
+// the first non-empty bucket around its minimum. inserting or decreasing below
+// the last extracted key throws std::logic_error (prim is not monotone).
+template <typename T>
+class RadixHeap final : public PriorityQueue<T> {
+private:
+    static const int NUM_BUCKETS = 33;
+
+    BucketLists buckets;
+    vector<int> keyOf;  // value -> key while queued
+    unsigned last;      // last extracted key
+    int count;
+    long opCount;
+
+    static int highBit(unsigned x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 31 - __builtin_clz(x);
+#else
+        int b = 0;
+        while (x >>= 1) b++;
+        return b;
+#endif
+    }
+
+    int bucketFor(int key) const {
+        unsigned k = (unsigned)key;
+        return k == last ? 0 : highBit(k ^ last) + 1;
+    }
+
+    void checkMonotone(int key) const {
+        if (key < 0 || (unsigned)key < last)
+            throw std::logic_error("RadixHeap: key below last extracted key (needs monotone keys, not usable for Prim)");
+    }
+
+public:
+    explicit RadixHeap(int maxVertices)
+        : buckets(NUM_BUCKETS, maxVertices), keyOf(maxVertices, 0), last(0), count(0), opCount(0) {}
+
+    void insert(int key, T value) override {
+        HEAP_STATS_OP(HEAP_INSERT);
+        checkMonotone(key);
+        HEAP_STATS_MOVE(1);
+        keyOf[value] = key;
+        buckets.push(bucketFor(key), value);
+        count++;
+        opCount++;
+    }
+
+    bool extractMin(int &outKey, T &outValue) override {
+        if (count == 0) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        size_t moved = 0;
+        if (buckets.empty(0)) {
+            int i = 1;
+            while (buckets.empty(i)) i++;
+            // new last = min key in bucket i, then every entry moves to a lower bucket
+            unsigned minKey = (unsigned)keyOf[buckets.front(i)];
+            for (int v = buckets.front(i); v >= 0; v = buckets.nextOf(v))
+                if ((unsigned)keyOf[v] < minKey) minKey = (unsigned)keyOf[v];
+            last = minKey;
+            for (int v = buckets.takeAll(i); v >= 0; ) {
+                int nx = buckets.nextOf(v);
+                buckets.push(bucketFor(keyOf[v]), v);
+                moved++;
+                v = nx;
+            }
+        }
+        HEAP_STATS_COMPARE(moved);
+        HEAP_STATS_MOVE(moved);
+        HEAP_STATS_SHAPE(moved);
+        int v = buckets.front(0);
+        buckets.remove(v);
+        outKey = (int)last;
+        outValue = v;
+        count--;
+        opCount++;
+        return true;
+    }
+
+    void decreaseKey(T value, int newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
+        if (buckets.bucketOf(value) < 0) return;
+        HEAP_STATS_COMPARE(1);
+        if (newKey >= keyOf[value]) return;
+        checkMonotone(newKey);
+        HEAP_STATS_MOVE(1);
+        buckets.remove(value);
+        keyOf[value] = newKey;
+        buckets.push(bucketFor(newKey), value);
+        opCount++;
+    }
+
+    bool isEmpty() const override { return count == 0; }
+
+    // rewind the monotone lower bound so an emptied queue can serve another query
+    void reset() { last = 0; }
+    long getOperationCount() const override { return opCount; }
+};
+
+#endif
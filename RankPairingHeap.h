@@ -0,0 +1,217 @@
+#ifndef RANK_PAIRING_HEAP_H
+#define RANK_PAIRING_HEAP_H
+
+#include "PriorityQueue.h"
+#include "NodePool.h"
+#include <vector>
+#include <utility>
+using std::vector;
+using std::swap;
+
+// rank-pairing heap (Haeupler, Sen, Tarjan): fibonacci bounds with pairing-heap
+// simplicity. every tree is a half tree (binary, root has only a left child,
+// each node's key <= everything in its left subtree). roots sit in one list linked
+// through right; extractMin links equal-rank roots in a single pass. decreaseKey
+// cuts the node with its left subtree, splices in its right child, then walks up
+// lowering ranks until one stays put. the rank rule picks the variant:
+//   Type1 - rank = max child rank, +1 when both are equal (0,i or 1,1 nodes)
+//   Type2 - +1 also when they differ by one (adds 1,2 nodes): shorter walks, looser shape
+enum class RankRule { Type1, Type2 };
+
+template <typename T, RankRule R>
+class BasicRankPairingHeap final : public PriorityQueue<T> {
+private:
+    // links are pool indices (NIL_NODE = none)
+    struct Node {
+        int key;
+        T value;
+        int rank;
+        NodeId left;    // first child
+        NodeId right;   // right child; next root for roots
+        NodeId parent;  // NIL for roots
+    };
+
+    NodePool<Node> pool;
+    NodeId minNode;
+    NodeId rootList;  // every root, minNode included, linked through right
+    vector<NodeId> nodeMapping;
+    vector<NodeId> rankTable;  // extractMin scratch, all NIL between calls
+    int maxRank;               // highest rankTable slot touched this extractMin
+    long opCount;
+
+    int rankOf(NodeId x) const { return x == NIL_NODE ? -1 : pool[x].rank; }
+
+    // root rank is its left child's rank + 1 (0 without children)
+    void makeRoot(NodeId x) {
+        Node& node = pool[x];
+        node.parent = NIL_NODE;
+        node.rank = rankOf(node.left) + 1;
+    }
+
+    void addRoot(NodeId x) {
+        pool[x].right = rootList;
+        rootList = x;
+        HEAP_STATS_COMPARE(1);
+        if (minNode == NIL_NODE || pool[x].key < pool[minNode].key)
+            minNode = x;
+    }
+
+    // two half trees of equal rank: the loser becomes the winner's left child,
+    // taking the winner's old left subtree as its right
+    NodeId link(NodeId x, NodeId y) {
+        HEAP_STATS_COMPARE(1);
+        HEAP_STATS_MOVE(1);
+        if (pool[y].key < pool[x].key) swap(x, y);
+        Node& W = pool[x];
+        Node& L = pool[y];
+        L.right = W.left;
+        if (W.left != NIL_NODE) pool[W.left].parent = y;
+        L.parent = x;
+        W.left = y;
+        W.rank++;
+        return x;
+    }
+
+    // one pass: each root either parks in the table or links with the parked root of
+    // the same rank and goes straight to the output list (not re-bucketed)
+    void collect(NodeId x, NodeId& out) {
+        int r = pool[x].rank;
+        if (r >= (int)rankTable.size()) rankTable.resize(r + 1, NIL_NODE);
+        if (r > maxRank) maxRank = r;
+        NodeId y = rankTable[r];
+        if (y == NIL_NODE) {
+            rankTable[r] = x;
+            return;
+        }
+        rankTable[r] = NIL_NODE;
+        x = link(x, y);
+        pool[x].right = out;
+        out = x;
+    }
+
+    int childRankRule(int a, int b) const {
+        int hi = a > b ? a : b;
+        int gap = a > b ? a - b : b - a;
+        if (R == RankRule::Type1) return gap == 0 ? hi + 1 : hi;
+        return gap <= 1 ? hi + 1 : hi;
+    }
+
+public:
+    BasicRankPairingHeap()
+        : minNode(NIL_NODE), rootList(NIL_NODE), rankTable(64, NIL_NODE), maxRank(-1), opCount(0) {}
+    explicit BasicRankPairingHeap(int maxVertices)
+        : pool(maxVertices), minNode(NIL_NODE), rootList(NIL_NODE), rankTable(64, NIL_NODE), maxRank(-1),
+          opCount(0) {
+        nodeMapping.resize(maxVertices, NIL_NODE);
+    }
+
+    void insert(int key, T value) override {
+        HEAP_STATS_OP(HEAP_INSERT);
+        NodeId id = pool.allocate();
+        Node& node = pool[id];
+        node.key = key;
+        node.value = value;
+        node.rank = 0;
+        node.left = node.right = node.parent = NIL_NODE;
+        if (!nodeMapping.empty() && value >= 0 && value < (int)nodeMapping.size())
+            nodeMapping[value] = id;
+        addRoot(id);
+        opCount++;
+    }
+
+    bool extractMin(int &outKey, T &outValue) override {
+        if (minNode == NIL_NODE) return false;
+        HEAP_STATS_OP(HEAP_EXTRACT_MIN);
+        NodeId oldMin = minNode;
+        outKey = pool[oldMin].key;
+        outValue = pool[oldMin].value;
+        if (!nodeMapping.empty() && outValue >= 0 && outValue < (int)nodeMapping.size())
+            nodeMapping[outValue] = NIL_NODE;
+
+        // the right spine of the min's left child falls apart into half trees
+        NodeId out = NIL_NODE;
+        size_t roots = 0;
+        maxRank = -1;
+        for (NodeId x = pool[oldMin].left; x != NIL_NODE;) {
+            NodeId next = pool[x].right;
+            pool[x].right = NIL_NODE;
+            makeRoot(x);
+            HEAP_STATS_MOVE(1);
+            collect(x, out);
+            x = next;
+            roots++;
+        }
+        for (NodeId x = rootList; x != NIL_NODE;) {
+            NodeId next = pool[x].right;
+            if (x != oldMin) collect(x, out);
+            x = next;
+            roots++;
+        }
+        HEAP_STATS_SHAPE(roots);
+        pool.release(oldMin);
+
+        minNode = rootList = NIL_NODE;
+        for (int r = 0; r <= maxRank; r++) {
+            if (rankTable[r] == NIL_NODE) continue;
+            addRoot(rankTable[r]);
+            rankTable[r] = NIL_NODE;
+        }
+        while (out != NIL_NODE) {
+            NodeId next = pool[out].right;
+            addRoot(out);
+            out = next;
+        }
+        opCount++;
+        return true;
+    }
+
+    void decreaseKey(T value, int newKey) override {
+        HEAP_STATS_OP(HEAP_DECREASE_KEY);
+        if (nodeMapping.empty() || value < 0 || value >= (int)nodeMapping.size()) return;
+        NodeId x = nodeMapping[value];
+        if (x == NIL_NODE) return;
+        Node& node = pool[x];
+        if (newKey >= node.key) return;
+        node.key = newKey;
+        opCount++;
+
+        if (node.parent == NIL_NODE) {
+            // a root: only the min pointer can change
+            HEAP_STATS_COMPARE(1);
+            if (newKey < pool[minNode].key) minNode = x;
+            return;
+        }
+
+        // cut x with its left subtree; its right child takes its place
+        NodeId u = node.parent;
+        NodeId y = node.right;
+        if (pool[u].left == x) pool[u].left = y;
+        else pool[u].right = y;
+        if (y != NIL_NODE) pool[y].parent = u;
+        node.right = NIL_NODE;
+        makeRoot(x);
+        HEAP_STATS_MOVE(1);
+        addRoot(x);
+
+        // restore ranks above the cut
+        while (true) {
+            Node& U = pool[u];
+            if (U.parent == NIL_NODE) {
+                U.rank = rankOf(U.left) + 1;
+                break;
+            }
+            int k = childRankRule(rankOf(U.left), rankOf(U.right));
+            if (k >= U.rank) break;
+            U.rank = k;
+            u = U.parent;
+        }
+    }
+
+    bool isEmpty() const override { return minNode == NIL_NODE; }
+    long getOperationCount() const override { return opCount; }
+};
+
+template <typename T> using RankPairingHeap1 = BasicRankPairingHeap<T, RankRule::Type1>;
+template <typename T> using RankPairingHeap2 = BasicRankPairingHeap<T, RankRule::Type2>;
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+using std::vector;
+
+// fixed set of worker threads started once and reused for every job.
+// runOnAll hands the same job to every worker (job(workerIndex)) and blocks
+// until all of them return; parallelFor builds dynamic scheduling on top.
+// jobs must not throw.
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads)
+        : job(nullptr), generation(0), pending(0), stopping(false) {
+        if (numThreads < 1) numThreads = 1;
+        for (int i = 0; i < numThreads; i++)
+            threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : threads) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)threads.size(); }
+
+    void runOnAll(const std::function<void(int)>& fn) {
+        std::unique_lock<std::mutex> lock(m);
+        job = &fn;
+        pending = (int)threads.size();
+        generation++;
+        wake.notify_all();
+        done.wait(lock, [this] { return pending == 0; });
+        job = nullptr;
+    }
+
+    // body(workerIndex, i) for i in [0, count), indices handed out one at a time
+    void parallelFor(int count, const std::function<void(int, int)>& body) {
+        std::atomic<int> next(0);
+        runOnAll([&](int worker) {
+            for (int i = next++; i < count; i = next++)
+                body(worker, i);
+        });
+    }
+
+    // default worker count: hardware threads, at least 1
+    static int hardwareThreads() {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw ? (int)hw : 1;
+    }
+
+private:
+    vector<std::thread> threads;
+    std::mutex m;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int)>* job;
+    long generation;
+    int pending;
+    bool stopping;
+
+    void workerLoop(int index) {
+        long seen = 0;
+        while (true) {
+            const std::function<void(int)>* fn;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                fn = job;
+            }
+            (*fn)(index);
+            {
+                std::lock_guard<std::mutex> lock(m);
+                if (--pending == 0) done.notify_one();
+            }
+        }
+    }
+};
+
+#endif
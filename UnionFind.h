@@ -0,0 +1,48 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <vector>
+#include <utility>
+using std::vector;
+
+// disjoint sets with union by size and path halving.
+// findRoot does not compress, so it is safe to call from many threads while
+// no unite is running.
+class UnionFind {
+public:
+    explicit UnionFind(int n) : parent(n), size(n, 1) {
+        for (int i = 0; i < n; i++) parent[i] = i;
+    }
+
+    int numElements() const { return (int)parent.size(); }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    int findRoot(int x) const {
+        while (parent[x] != x) x = parent[x];
+        return x;
+    }
+
+    // false if already in the same set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+
+private:
+    vector<int> parent;
+    vector<int> size;
+};
+
+#endif
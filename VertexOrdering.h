@@ -0,0 +1,257 @@
+#ifndef VERTEX_ORDERING_H
+#define VERTEX_ORDERING_H
+
+#include "CSRGraph.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+using std::vector;
+
+// a renumbering of the vertices: newId[v] for original vertex v, oldId[u] for new
+// vertex u. run an algorithm on apply(g) from newId[source], then toOriginal maps
+// its per-vertex results back to the original ids.
+struct Relabeling {
+    vector<int> newId;
+    vector<int> oldId;
+
+    // order: the original vertices in their new order (order[i] becomes vertex i);
+    // must list each of 0..n-1 exactly once, else std::invalid_argument
+    explicit Relabeling(const vector<int>& order) : newId(order.size(), -1), oldId(order) {
+        for (size_t i = 0; i < order.size(); i++) {
+            int v = order[i];
+            if (v < 0 || v >= (int)order.size() || newId[v] >= 0)
+                throw std::invalid_argument("Relabeling: order is not a permutation of the vertices");
+            newId[v] = (int)i;
+        }
+    }
+
+    // g renumbered: vertex u of the result is oldId[u] of g, with the same edges in
+    // the same per-vertex order (targets renumbered)
+    template <typename GraphT>
+    CSRGraph apply(const GraphT& g) const {
+        int n = g.numVertices;
+        CSRGraph r;
+        r.numVertices = n;
+        r.offsets.assign((size_t)n + 1, 0);
+        for (int u = 0; u < n; u++) {
+            long long degree = 0;
+            for (const auto& e : g.neighbors(oldId[u])) {
+                (void)e;
+                degree++;
+            }
+            r.offsets[u + 1] = r.offsets[u] + degree;
+        }
+        r.edges.resize((size_t)r.offsets[n]);
+        for (int u = 0; u < n; u++) {
+            size_t i = (size_t)r.offsets[u];
+            for (const auto& e : g.neighbors(oldId[u])) r.edges[i++] = { newId[e.target], e.weight };
+        }
+        return r;
+    }
+
+    // byNew indexed by new ids -> byOld indexed by original ids
+    template <typename T>
+    void toOriginal(const vector<T>& byNew, vector<T>& byOld) const {
+        byOld.resize(byNew.size());
+        for (size_t v = 0; v < byNew.size(); v++) byOld[v] = byNew[newId[v]];
+    }
+};
+
+// vertex orders that put vertices touched together next to each other in memory, so
+// dist[], heap position maps and the CSR rows of a search front share cache lines.
+// all take a CSR-like graph (numVertices, neighbors(u)); directed graphs are ordered
+// along their out-arcs. every vertex gets an id, unreachable ones included.
+class VertexOrdering {
+public:
+    enum Kind { ORIGINAL, BFS, RCM, DEGREE, HILBERT };
+
+    static const char* name(Kind k) {
+        switch (k) {
+        case ORIGINAL: return "original";
+        case BFS: return "bfs";
+        case RCM: return "rcm";
+        case DEGREE: return "degree";
+        default: return "hilbert";
+        }
+    }
+
+    static Relabeling identity(int n) {
+        vector<int> order(n);
+        for (int v = 0; v < n; v++) order[v] = v;
+        return Relabeling(order);
+    }
+
+    // breadth-first discovery order from start, then from the lowest unreached id
+    template <typename GraphT>
+    static Relabeling bfs(const GraphT& g, int start) {
+        int n = g.numVertices;
+        vector<int> order;
+        order.reserve(n);
+        vector<char> seen(n, 0);
+        for (int i = -1; i < n; i++) {
+            int root = i < 0 ? start : i;
+            if (root < 0 || root >= n || seen[root]) continue;
+            seen[root] = 1;
+            order.push_back(root);
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                for (const auto& e : g.neighbors(order[head])) {
+                    if (seen[e.target]) continue;
+                    seen[e.target] = 1;
+                    order.push_back(e.target);
+                }
+            }
+        }
+        return Relabeling(order);
+    }
+
+    // reverse cuthill-mckee: per component, BFS from a pseudo-peripheral vertex
+    // (george-liu: restart from a lowest-degree vertex of the last level while the
+    // depth grows), each vertex's new neighbours taken by increasing degree; the
+    // whole order reversed. keeps edges close to the diagonal (low bandwidth).
+    // the searches skip placed vertices; on a directed graph the peripheral start may
+    // not reach the lowest-degree root, which then starts the next component.
+    template <typename GraphT>
+    static Relabeling rcm(const GraphT& g) {
+        int n = g.numVertices;
+        vector<int> deg = degrees(g);
+        vector<int> byDegree(n);
+        for (int v = 0; v < n; v++) byDegree[v] = v;
+        std::stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return deg[a] < deg[b]; });
+
+        vector<int> order, level;
+        order.reserve(n);
+        vector<int> stamp(n, 0);  // BFS number that last reached v (0: none)
+        vector<char> placed(n, 0);
+        int bfsCount = 0;
+        for (size_t i = 0; i < byDegree.size();) {
+            int root = byDegree[i];
+            if (placed[root]) {
+                i++;
+                continue;
+            }
+            // pseudo-peripheral start: deepest level, lowest degree
+            int depth = levelBFS(g, root, placed, stamp, ++bfsCount, level);
+            for (int tries = 0; tries < 8; tries++) {
+                int next = level.back();
+                for (int v : level)
+                    if (deg[v] < deg[next]) next = v;
+                int d = levelBFS(g, next, placed, stamp, ++bfsCount, level);
+                if (d <= depth) break;
+                root = next;
+                depth = d;
+            }
+            size_t head = order.size();
+            placed[root] = 1;
+            order.push_back(root);
+            for (; head < order.size(); head++) {
+                size_t first = order.size();
+                for (const auto& e : g.neighbors(order[head])) {
+                    if (placed[e.target]) continue;
+                    placed[e.target] = 1;
+                    order.push_back(e.target);
+                }
+                std::stable_sort(order.begin() + first, order.end(),
+                                 [&](int a, int b) { return deg[a] < deg[b]; });
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return Relabeling(order);
+    }
+
+    // highest out-degree first (ties by id): hubs, touched by most relaxations, share lines
+    template <typename GraphT>
+    static Relabeling degree(const GraphT& g) {
+        int n = g.numVertices;
+        vector<int> d = degrees(g);
+        vector<int> order(n);
+        for (int v = 0; v < n; v++) order[v] = v;
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return d[a] > d[b]; });
+        return Relabeling(order);
+    }
+
+    // rows x cols grid with vertex r * cols + c (GraphGenerators::grid): cells in
+    // hilbert-curve order, so nearby cells get nearby ids in both directions
+    static Relabeling hilbert(int rows, int cols) {
+        int side = 1;
+        while (side < rows || side < cols) side *= 2;
+        vector<uint64_t> key((size_t)rows * cols);
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++) key[(size_t)r * cols + c] = hilbertIndex(side, c, r);
+        vector<int> order(key.size());
+        for (size_t v = 0; v < order.size(); v++) order[v] = (int)v;
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return key[a] < key[b]; });
+        return Relabeling(order);
+    }
+
+    // mean |u - v| over all arcs u -> v: how far apart in memory an edge scan reaches
+    template <typename GraphT>
+    static double meanEdgeGap(const GraphT& g) {
+        long long arcs = 0;
+        double sum = 0;
+        for (int u = 0; u < g.numVertices; u++) {
+            for (const auto& e : g.neighbors(u)) {
+                sum += e.target > u ? e.target - u : u - e.target;
+                arcs++;
+            }
+        }
+        return arcs > 0 ? sum / arcs : 0;
+    }
+
+private:
+    template <typename GraphT>
+    static vector<int> degrees(const GraphT& g) {
+        vector<int> d(g.numVertices, 0);
+        for (int u = 0; u < g.numVertices; u++)
+            for (const auto& e : g.neighbors(u)) {
+                (void)e;
+                d[u]++;
+            }
+        return d;
+    }
+
+    // BFS from root over unplaced vertices marking stamp = id; returns the number of
+    // levels, last holds the deepest level
+    template <typename GraphT>
+    static int levelBFS(const GraphT& g, int root, const vector<char>& placed, vector<int>& stamp, int id,
+                        vector<int>& last) {
+        vector<int> current(1, root), next;
+        stamp[root] = id;
+        int depth = 1;
+        while (true) {
+            next.clear();
+            for (int u : current) {
+                for (const auto& e : g.neighbors(u)) {
+                    if (stamp[e.target] == id || placed[e.target]) continue;
+                    stamp[e.target] = id;
+                    next.push_back(e.target);
+                }
+            }
+            if (next.empty()) break;
+            current.swap(next);
+            depth++;
+        }
+        last.swap(current);
+        return depth;
+    }
+
+    // position of (x, y) along the hilbert curve filling a side x side square (side a power of two)
+    static uint64_t hilbertIndex(int side, int x, int y) {
+        uint64_t d = 0;
+        for (int s = side / 2; s > 0; s /= 2) {
+            int rx = (x & s) > 0;
+            int ry = (y & s) > 0;
+            d += (uint64_t)s * s * ((3 * rx) ^ ry);
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = side - 1 - x;
+                    y = side - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return d;
+    }
+};
+
+#endif
@@ -1,5 +1,10 @@
-// comparative run: dijkstra vs prim, binary/pairing/fib heaps, random/grid/worst-case graphs.
-// output: results.txt + console (Algo, HeapType, GraphClass, GraphType, N, TimeUS, Ops)
+// comparative run: dijkstra vs prim, binary/pairing/fib heaps, random/grid/worst-case graphs
+// or graph files (--graph: DIMACS .gr, edge list, binary .csrg).
+// every measurement gets warmup runs and repeated trials in shuffled order (see --help).
+// output: results.txt (csv or json) + console csv (Algo, HeapType, GraphClass, GraphType, N,
+//         TimeUS, Ops, CSRTimeUS, CSRSavedPct, StaticTimeUS, VirtualCostPct,
+//         Trials, MinUS, MedianUS, P95US, MeanUS, CI95US,
+//         Cycles, Instructions, IPC, L1DMisses, LLCMisses, BranchMisses, DTLBMisses)
 
 #include <iostream>
 #include <fstream>
@@ -9,238 +14,1629 @@
 #include <string>
 #include <cmath>
 #include <cstdio>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include "Benchmark.h"
 #include "Graph.h"
+#include "CSRGraph.h"
 #include "BinaryHeap.h"
+#include "DaryHeap.h"
+#include "PackedHeap.h"
 #include "FibonacciHeap.h"
+#include "RankPairingHeap.h"
+#include "HollowHeap.h"
 #include "PairingHeap.h"
+#include "RadixHeap.h"
+#include "DialQueue.h"
+#include "LazyHeap.h"
 #include "Algorithms.h"
+#include "BatchDijkstra.h"
+#include "DeltaStepping.h"
+#include "ParallelMST.h"
+#include "PerfCounters.h"
+#include "HeapTrace.h"
+#include "GraphIO.h"
+#include "GraphGenerators.h"
+#include "ALT.h"
+#include "ContractionHierarchy.h"
+#include "DynamicEngine.h"
+#include "VertexOrdering.h"
 
 using namespace std;
 
-// graph generators
+typedef chrono::steady_clock Clock;
 
-// ~ edgeMult*N undir edges, rand u,v,w
-void generateRandomSparse(Graph& g, int edgeMultiplier) {
-    int n = g.numVertices;
-    int numEdges = n * edgeMultiplier;
-    for (int i = 0; i < numEdges; i++) {
-        int u = rand() % n;
-        int v = rand() % n;
-        if (u == v) continue;
-        int w = 1 + rand() % 100;
-        g.addUndirectedEdge(u, v, w);
+static double elapsedUs(Clock::time_point t0) {
+    return chrono::duration<double, micro>(Clock::now() - t0).count();
+}
+
+template <typename GraphT, typename PQ>
+static double timeDijkstra(const GraphT& g, PQ& pq, vector<int>& dist) {
+    auto t0 = Clock::now();
+    Algorithms::runDijkstra(g, 0, pq, dist);
+    return elapsedUs(t0);
+}
+
+template <typename GraphT, typename PQ>
+static double timePrim(const GraphT& g, PQ& pq, vector<int>& minEdge, int& totalWeight) {
+    auto t0 = Clock::now();
+    Algorithms::runPrim(g, 0, pq, minEdge, totalWeight);
+    return elapsedUs(t0);
+}
+
+// heap columns, in results.txt order
+typedef unique_ptr<PriorityQueue<int>> (*HeapFactory)(int);
+
+template <template <typename> class H>
+static unique_ptr<PriorityQueue<int>> makeHeap(int n) {
+    return unique_ptr<PriorityQueue<int>>(new H<int>(n));
+}
+
+// same runs through the concrete heap type (static dispatch, no virtual calls)
+template <template <typename> class H>
+static double timeDijkstraStatic(const Graph& g, vector<int>& dist) {
+    H<int> pq(g.numVertices);
+    return timeDijkstra(g, pq, dist);
+}
+
+template <template <typename> class H>
+static double timePrimStatic(const Graph& g, vector<int>& minEdge, int& totalWeight) {
+    H<int> pq(g.numVertices);
+    return timePrim(g, pq, minEdge, totalWeight);
+}
+
+// monotoneOnly: integer queues that need non-decreasing extracted keys (dijkstra only, no prim rows)
+struct HeapColumn {
+    const char* name;
+    HeapFactory make;
+    double (*staticDijkstra)(const Graph&, vector<int>&);
+    double (*staticPrim)(const Graph&, vector<int>&, int&);
+    bool monotoneOnly;
+};
+
+template <template <typename> class H>
+static HeapColumn column(const char* name, bool monotoneOnly = false) {
+    return { name, makeHeap<H>, timeDijkstraStatic<H>, timePrimStatic<H>, monotoneOnly };
+}
+
+static const HeapColumn heapColumns[] = {
+    column<BinaryHeap>("Binary"),
+    column<PairingHeap>("Pairing"),
+    column<MultipassPairingHeap>("PairingMultipass"),
+    column<AuxPairingHeap>("PairingAux"),
+    column<FibonacciHeap>("Fibonacci"),
+    column<RankPairingHeap1>("RankPairing1"),
+    column<RankPairingHeap2>("RankPairing2"),
+    column<HollowHeap>("Hollow"),
+    column<DaryHeap4>("4-ary"),
+    column<DaryHeap8>("8-ary"),
+    column<DaryHeap16>("16-ary"),
+    column<PackedBinaryHeap>("Binary-packed"),
+    column<PackedDaryHeap4>("4-ary-packed"),
+    column<PackedDaryHeap8>("8-ary-packed"),
+    column<RadixHeap>("Radix", true),
+    column<DialQueue>("Dial", true),
+};
+static const int numHeaps = sizeof(heapColumns) / sizeof(heapColumns[0]);
+
+static const char* const algoNames[] = { "dijkstra", "prim", "boruvka", "filterkruskal" };
+static const char* const classNames[] = { "random", "grid", "worst_case" };
+
+// the three timings behind one row: adjacency list + virtual dispatch (TimeUS),
+// CSR copy + virtual dispatch (CSRTimeUS), adjacency list + concrete heap type (StaticTimeUS)
+enum Layout { LIST, CSR, STATIC, NUM_LAYOUTS };
+
+// one timed run; heap is the list-layout heap after the run (for fib_stats.txt), if any
+struct Sample {
+    double us;
+    long ops;
+    bool ok;  // result matched the reference
+    unique_ptr<PriorityQueue<int>> heap;
+    PerfCounters::Reading perf;  // list-layout heap runs only, otherwise all invalid
+
+    Sample() : us(0), ops(0), ok(true), perf() {}
+};
+
+// hardware counters of the main thread, opened once
+static PerfCounters& perfCounters() {
+    static PerfCounters counters;
+    return counters;
+}
+
+// times one list-layout heap run and reads the hardware counters around it
+// (counter start/stop stay outside the timed region)
+template <typename F>
+static void timeWithCounters(Sample& s, F run) {
+    perfCounters().start();
+    s.us = run();
+    s.perf = perfCounters().stop();
+}
+
+// one results row: an algorithm/heap pair, run once per layout per trial
+struct BenchCase {
+    const char* algo;
+    const char* heap;
+    bool hasStatic;  // false for heap-free engines (StaticTimeUS = TimeUS)
+    function<Sample(Layout)> run;
+    long ops;
+    bool ok;
+    vector<double> us[NUM_LAYOUTS];
+    vector<uint64_t> perf[PerfCounters::NUM_EVENTS];  // per timed list run, valid readings only
+    unique_ptr<PriorityQueue<int>> firstHeap;  // heap of the first timed list run, for the side files
+    string skipped;  // non-empty: the heap rejected this graph (logic_error text), no row
+
+    BenchCase(const char* a, const char* h, bool s, function<Sample(Layout)> r)
+        : algo(a), heap(h), hasStatic(s), run(r), ops(0), ok(true) {}
+};
+
+// CSRT: the CSR copy of g (CSRGraph) or the mapped file it was read from (MappedCSRGraph)
+template <typename CSRT>
+static void addDijkstraCases(vector<BenchCase>& cases, const Graph& g, const CSRT& csr,
+                             const vector<int>& ref, const BenchOptions& opts) {
+    for (int h = 0; h < numHeaps; h++) {
+        const HeapColumn& col = heapColumns[h];
+        if (!opts.wantHeap(col.name)) continue;
+        cases.emplace_back("Dijkstra", col.name, true, [&g, &csr, &ref, &col](Layout layout) {
+            Sample s;
+            vector<int> dist;
+            if (layout == STATIC) {
+                s.us = col.staticDijkstra(g, dist);
+            } else if (layout == CSR) {
+                unique_ptr<PriorityQueue<int>> pq = col.make(g.numVertices);
+                s.us = timeDijkstra(csr, *pq, dist);
+                s.ops = pq->getOperationCount();
+            } else {
+                unique_ptr<PriorityQueue<int>> pq = col.make(g.numVertices);
+                timeWithCounters(s, [&] { return timeDijkstra(g, *pq, dist); });
+                s.ops = pq->getOperationCount();
+                s.heap = move(pq);
+            }
+            s.ok = dist == ref;
+            return s;
+        });
     }
 }
 
-// frac of max edges n(n-1)/2
-void generateRandomDense(Graph& g, double edgeFraction) {
-    int n = g.numVertices;
-    long maxEdges = (long)n * (n - 1) / 2;
-    long target = (long)(maxEdges * edgeFraction);
-    for (long i = 0; i < target; i++) {
-        int u = rand() % n;
-        int v = rand() % n;
-        if (u == v) continue;
-        int w = 1 + rand() % 100;
-        g.addUndirectedEdge(u, v, w);
-    }
-}
-
-// 2d grid rows*cols, 4-neighbor, w 1..100
-void generateGrid(Graph& g, int rows, int cols) {
-    int n = rows * cols;
-    if (g.numVertices != n) return;
-    for (int r = 0; r < rows; r++) {
-        for (int c = 0; c < cols; c++) {
-            int u = r * cols + c;
-            int w;
-            if (c + 1 < cols) {
-                w = 1 + rand() % 100;
-                g.addUndirectedEdge(u, r * cols + (c + 1), w);
+template <typename CSRT>
+static void addPrimCases(vector<BenchCase>& cases, const Graph& g, const CSRT& csr,
+                         const int& refTotal, const BenchOptions& opts) {
+    for (int h = 0; h < numHeaps; h++) {
+        const HeapColumn& col = heapColumns[h];
+        if (col.monotoneOnly || !opts.wantHeap(col.name)) continue;
+        cases.emplace_back("Prim", col.name, true, [&g, &csr, &refTotal, &col](Layout layout) {
+            Sample s;
+            vector<int> minEdge;
+            int total = 0;
+            if (layout == STATIC) {
+                s.us = col.staticPrim(g, minEdge, total);
+            } else if (layout == CSR) {
+                unique_ptr<PriorityQueue<int>> pq = col.make(g.numVertices);
+                s.us = timePrim(csr, *pq, minEdge, total);
+                s.ops = pq->getOperationCount();
+            } else {
+                unique_ptr<PriorityQueue<int>> pq = col.make(g.numVertices);
+                timeWithCounters(s, [&] { return timePrim(g, *pq, minEdge, total); });
+                s.ops = pq->getOperationCount();
+                s.heap = move(pq);
             }
-            if (r + 1 < rows) {
-                w = 1 + rand() % 100;
-                g.addUndirectedEdge(u, (r + 1) * cols + c, w);
+            s.ok = total == refTotal;
+            return s;
+        });
+    }
+}
+
+// pool shared by the graph generators and the heap-free MST engines
+static ThreadPool& workerPool() {
+    static ThreadPool pool(ThreadPool::hardwareThreads());
+    return pool;
+}
+
+// heap-free MST engine rows next to Prim: HeapType none, Ops 0, no static column.
+// no counter columns either: the counters only see the main thread, not the pool
+template <typename CSRT, typename Engine>
+static void addMSTEngineCase(vector<BenchCase>& cases, const char* algo, const Graph& g, const CSRT& csr,
+                             const int& refTotal, Engine engine) {
+    cases.emplace_back(algo, "none", false, [&g, &csr, &refTotal, engine](Layout layout) {
+        Sample s;
+        int total = 0;
+        auto t0 = Clock::now();
+        if (layout == LIST) engine(g, total);
+        else engine(csr, total);
+        s.us = elapsedUs(t0);
+        s.ok = total == refTotal;
+        return s;
+    });
+}
+
+// percent of base saved by other (negative if slower)
+static string pct(double base, double other) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.1f", base > 0 ? 100.0 * (base - other) / base : 0.0);
+    return buf;
+}
+
+static string us(double v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.1f", v);
+    return buf;
+}
+
+// median of the counter readings, "" if the event was never read
+static string medianCount(vector<uint64_t> v) {
+    if (v.empty()) return "";
+    nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    return to_string(v[v.size() / 2]);
+}
+
+// results.txt rows, csv or one json array of objects keyed by the csv column names
+// (plus SamplesUS, the raw TimeUS trials); the console always gets csv
+class ResultWriter {
+public:
+    ResultWriter(ostream& out, ostream& log, bool json) : out(out), log(log), json(json), rows(0) {
+        log << header;
+        out << (json ? "[\n" : header);
+    }
+
+    void write(const BenchCase& c, const char* graphClass, const char* graphType, int N) {
+        TrialStats list = TrialStats::of(c.us[LIST]);
+        TrialStats csr = TrialStats::of(c.us[CSR]);
+        TrialStats stat = c.hasStatic ? TrialStats::of(c.us[STATIC]) : list;
+        const string values[] = {
+            c.algo, c.heap, graphClass, graphType, to_string(N),
+            us(list.medianUs), to_string(c.ops),
+            us(csr.medianUs), pct(list.medianUs, csr.medianUs),
+            us(stat.medianUs), pct(list.medianUs, stat.medianUs),
+            to_string(list.trials), us(list.minUs), us(list.medianUs), us(list.p95Us),
+            us(list.meanUs), us(list.ci95Us),
+            medianCount(c.perf[PerfCounters::CYCLES]), medianCount(c.perf[PerfCounters::INSTRUCTIONS]),
+            ipc(c), medianCount(c.perf[PerfCounters::L1D_MISSES]), medianCount(c.perf[PerfCounters::LLC_MISSES]),
+            medianCount(c.perf[PerfCounters::BRANCH_MISSES]), medianCount(c.perf[PerfCounters::DTLB_MISSES])
+        };
+        const int numValues = sizeof(values) / sizeof(values[0]);
+        const int numText = 4;  // Algo..GraphType are strings
+
+        string line;
+        for (int i = 0; i < numValues; i++)
+            line += (i ? "," : "") + values[i];
+        line += "\n";
+        log << line;
+        if (!json) {
+            out << line;
+            return;
+        }
+
+        out << (rows++ ? ",\n" : "") << "  {";
+        for (int i = 0; i < numValues; i++) {
+            out << (i ? ", " : "") << "\"" << columns[i] << "\": ";
+            if (i < numText) out << "\"" << jsonEscape(values[i]) << "\"";
+            else out << (values[i].empty() ? "null" : values[i]);
+        }
+        out << ", \"SamplesUS\": [";
+        for (size_t i = 0; i < c.us[LIST].size(); i++)
+            out << (i ? ", " : "") << us(c.us[LIST][i]);
+        out << "]}";
+    }
+
+    void finish() {
+        if (json) out << "\n]\n";
+    }
+
+private:
+    // json string body: quotes, backslashes and control characters escaped (GraphType
+    // is a --graph file's basename, so it can hold any of them)
+    static string jsonEscape(const string& s) {
+        string r;
+        for (char ch : s) {
+            unsigned char c = (unsigned char)ch;
+            if (c == '"' || c == '\\') {
+                r += '\\';
+                r += ch;
+            } else if (c < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                r += buf;
+            } else {
+                r += ch;
             }
         }
+        return r;
     }
+
+    // instructions per cycle from the median readings, "" without both counters
+    static string ipc(const BenchCase& c) {
+        string cycles = medianCount(c.perf[PerfCounters::CYCLES]);
+        string instructions = medianCount(c.perf[PerfCounters::INSTRUCTIONS]);
+        if (cycles.empty() || instructions.empty() || cycles == "0") return "";
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.2f", stod(instructions) / stod(cycles));
+        return buf;
+    }
+
+    static const char* const header;
+    static const char* const columns[];
+    ostream& out;
+    ostream& log;
+    bool json;
+    int rows;
+};
+
+const char* const ResultWriter::header =
+    "Algo,HeapType,GraphClass,GraphType,N,TimeUS,Ops,CSRTimeUS,CSRSavedPct,StaticTimeUS,VirtualCostPct,"
+    "Trials,MinUS,MedianUS,P95US,MeanUS,CI95US,"
+    "Cycles,Instructions,IPC,L1DMisses,LLCMisses,BranchMisses,DTLBMisses\n";
+const char* const ResultWriter::columns[] = {
+    "Algo", "HeapType", "GraphClass", "GraphType", "N", "TimeUS", "Ops", "CSRTimeUS", "CSRSavedPct",
+    "StaticTimeUS", "VirtualCostPct", "Trials", "MinUS", "MedianUS", "P95US", "MeanUS", "CI95US",
+    "Cycles", "Instructions", "IPC", "L1DMisses", "LLCMisses", "BranchMisses", "DTLBMisses"
+};
+
+// fibonacci link/cut counters for one run (fib_stats.txt)
+static void writeFibStats(ostream& fibOut, const PriorityQueue<int>* pq, const char* algo,
+                          const char* graphClass, const char* graphType, int N) {
+    const FibonacciHeap<int>* fh = dynamic_cast<const FibonacciHeap<int>*>(pq);
+    if (!fh) return;
+    long extracts = fh->getExtractCount();
+    char perExtract[32];
+    snprintf(perExtract, sizeof(perExtract), "%.2f", extracts > 0 ? (double)fh->getLinkCount() / extracts : 0.0);
+    fibOut << algo << "," << graphClass << "," << graphType << "," << N << "," << extracts << ","
+           << fh->getLinkCount() << "," << fh->getCutCount() << "," << perExtract << "\n";
 }
 
-// layered: sqrt(n) layers, full bipartite between adjacent layers (stress decreaseKey)
-void generateWorstCaseLayered(Graph& g) {
-    int n = g.numVertices;
-    if (n <= 1) return;
-    int L = (int)sqrt(n);
-    if (L < 2) L = 2;
-    vector<int> layerStart(L + 1);
-    int perLayer = (n + L - 1) / L;
-    for (int i = 0; i <= L; i++)
-        layerStart[i] = min(i * perLayer, n);
-
-    for (int i = 0; i < L - 1; i++) {
-        int a = layerStart[i], aEnd = layerStart[i + 1];
-        int b = layerStart[i + 1], bEnd = layerStart[i + 2];
-        for (int u = a; u < aEnd; u++) {
-            for (int v = b; v < bEnd; v++) {
-                int w = 1 + rand() % 100;
-                g.addUndirectedEdge(u, v, w);
+#ifdef HEAP_STATS
+// per-operation calls, comparisons, moves and latency percentiles (heap_stats.txt),
+// and the non-empty latency histogram buckets (heap_histograms.txt)
+static void writeHeapStats(ostream& statsOut, ostream& histOut, const PriorityQueue<int>* pq, const char* algo,
+                           const char* heap, const char* graphClass, const char* graphType, int N) {
+    const HeapStats& st = pq->getStats();
+    const HeapStats::OpStats& extracts = st.ops[HEAP_EXTRACT_MIN];
+    char shapeMean[32];
+    snprintf(shapeMean, sizeof(shapeMean), "%.2f",
+             extracts.calls ? (double)st.extractShapeSum / extracts.calls : 0.0);
+    for (int op = 0; op < NUM_HEAP_OPS; op++) {
+        const HeapStats::OpStats& o = st.ops[op];
+        const LatencyHistogram& h = o.latency;
+        string prefix = string(algo) + "," + heap + "," + graphClass + "," + graphType + "," + to_string(N) + ","
+                      + heapOpName(op) + ",";
+        statsOut << prefix << o.calls << "," << o.comparisons << "," << o.moves << ","
+                 << h.percentile(0.5) << "," << h.percentile(0.9) << "," << h.percentile(0.99) << ","
+                 << h.max() << "," << (op == HEAP_EXTRACT_MIN ? shapeMean : "") << ","
+                 << (op == HEAP_EXTRACT_MIN ? to_string(st.extractShapeMax) : "") << "\n";
+        for (int b = 0; b < LatencyHistogram::NUM_BUCKETS; b++)
+            if (h.bucketCount(b))
+                histOut << prefix << LatencyHistogram::bucketLow(b) << "," << h.bucketCount(b) << "\n";
+    }
+}
+#endif
+
+// per-run side files, filled from the first timed list run of every row
+struct RunStatsFiles {
+    ofstream fib;         // fib_stats.txt
+#ifdef HEAP_STATS
+    ofstream ops;         // heap_stats.txt, next to the results file
+    ofstream histograms;  // heap_histograms.txt, next to the results file
+#endif
+};
+
+static void writeRunStats(RunStatsFiles& files, const PriorityQueue<int>* pq, const char* algo, const char* heap,
+                          const char* graphClass, const char* graphType, int N) {
+    if (!pq) return;
+    writeFibStats(files.fib, pq, algo, graphClass, graphType, N);
+#ifdef HEAP_STATS
+    writeHeapStats(files.ops, files.histograms, pq, algo, heap, graphClass, graphType, N);
+#else
+    (void)heap;
+#endif
+}
+
+// warmup rounds then timed rounds; every round runs each (case, layout) once in a
+// fresh random order, so no heap is always first on a cold cache or always after
+// the same neighbour. ops and firstHeap come from the first timed list run.
+// a case whose heap throws logic_error (dial with weights above its bucket range,
+// e.g. on a file graph) is dropped for the rest of the cell.
+static void measure(vector<BenchCase>& cases, const BenchOptions& opts, mt19937& rng) {
+    vector<pair<int, Layout>> order;
+    for (int c = 0; c < (int)cases.size(); c++)
+        for (int l = 0; l < NUM_LAYOUTS; l++)
+            if (l != STATIC || cases[c].hasStatic)
+                order.push_back(make_pair(c, (Layout)l));
+
+    for (int round = -opts.warmup; round < opts.trials; round++) {
+        shuffle(order.begin(), order.end(), rng);
+        for (const auto& m : order) {
+            BenchCase& c = cases[m.first];
+            if (!c.skipped.empty()) continue;
+            Sample s;
+            try {
+                s = c.run(m.second);
+            } catch (const logic_error& e) {
+                c.skipped = e.what();
+                continue;
+            }
+            if (!s.ok) c.ok = false;
+            if (round < 0) continue;
+            c.us[m.second].push_back(s.us);
+            for (int e = 0; e < PerfCounters::NUM_EVENTS; e++)
+                if (s.perf.valid[e]) c.perf[e].push_back(s.perf.value[e]);
+            if (round == 0 && m.second == LIST) {
+                c.ops = s.ops;
+                c.firstHeap = move(s.heap);
             }
         }
     }
 }
 
-// one csv row
-static void writeLine(ostream& out, ostream& log,
-                      const char* algo, const char* heap, const char* graphClass,
-                      const char* graphType, int N, long timeUs, long ops) {
-    out << algo << "," << heap << "," << graphClass << "," << graphType << "," << N << "," << timeUs << "," << ops << "\n";
-    log << algo << "," << heap << "," << graphClass << "," << graphType << "," << N << "," << timeUs << "," << ops << "\n";
+// the reference run's heap calls as DIR/<algo>_<graphType>_<N>.trace (--trace-dir)
+static void saveTrace(HeapTrace& trace, const BenchOptions& opts, const char* algo, const char* graphClass,
+                      const char* graphType, int N) {
+    if (opts.traceDir.empty()) return;
+    trace.numVertices = N;
+    trace.label = string(algo) + "," + graphClass + "," + graphType + "," + to_string(N);
+    string name = string(algo) + "_" + graphType + "_" + to_string(N) + ".trace";
+    for (char& ch : name) ch = (char)tolower((unsigned char)ch);
+    string path = opts.traceDir + "/" + name;
+    if (!trace.save(path))
+        cerr << "Could not write trace " << path << "\n";
 }
 
-void runDijkstra(const Graph& g, int N, const char* graphClass, const char* graphType,
-                 ostream& out, ostream& log) {
-    vector<int> distB, distP, distF;
+// all selected algorithm/heap rows for one graph, checked against a binary-heap reference run
+template <typename CSRT>
+static void runCell(const Graph& g, const CSRT& csr, int N, const char* graphClass, const char* graphType,
+                    const BenchOptions& opts, mt19937& rng, ResultWriter& results, RunStatsFiles& files,
+                    bool symmetric = true) {
     int n = g.numVertices;
+    vector<BenchCase> cases;
 
-    BinaryHeap<int> bh(n);
-    auto t0 = chrono::high_resolution_clock::now();
-    Algorithms::runDijkstra(g, 0, &bh, distB);
-    auto t1 = chrono::high_resolution_clock::now();
-    long usB = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
-    long opsB = bh.getOperationCount();
-
-    PairingHeap<int> ph(n);
-    t0 = chrono::high_resolution_clock::now();
-    Algorithms::runDijkstra(g, 0, &ph, distP);
-    t1 = chrono::high_resolution_clock::now();
-    long usP = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
-    long opsP = ph.getOperationCount();
-
-    FibonacciHeap<int> fh(n);
-    t0 = chrono::high_resolution_clock::now();
-    Algorithms::runDijkstra(g, 0, &fh, distF);
-    t1 = chrono::high_resolution_clock::now();
-    long usF = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
-    long opsF = fh.getOperationCount();
-
-    writeLine(out, log, "Dijkstra", "Binary", graphClass, graphType, N, usB, opsB);
-    writeLine(out, log, "Dijkstra", "Pairing", graphClass, graphType, N, usP, opsP);
-    writeLine(out, log, "Dijkstra", "Fibonacci", graphClass, graphType, N, usF, opsF);
-
-    if (distB != distP || distP != distF)
-        cerr << "Correctness warning: Dijkstra dist mismatch for " << graphClass << " " << graphType << " N=" << N << "\n";
-}
-
-void runPrim(const Graph& g, int N, const char* graphClass, const char* graphType,
-             ostream& out, ostream& log) {
-    vector<int> minEdgeB, minEdgeP, minEdgeF;
-    int totalB = 0, totalP = 0, totalF = 0;
+    vector<int> refDist;
+    if (opts.wantAlgo("dijkstra")) {
+        BinaryHeap<int> bh(n);
+        HeapTrace trace;
+        RecordingQueue<int> rec(bh, trace);
+        if (opts.traceDir.empty()) Algorithms::runDijkstra(g, 0, bh, refDist);
+        else Algorithms::runDijkstra(g, 0, rec, refDist);
+        saveTrace(trace, opts, "Dijkstra", graphClass, graphType, N);
+        addDijkstraCases(cases, g, csr, refDist, opts);
+    }
+
+    // prim's total on a directed graph depends on tie order, and the MST engines read
+    // each arc as an undirected edge: no MST rows unless every arc has its reverse
+    bool wantMST = opts.wantAlgo("prim") || opts.wantAlgo("boruvka") || opts.wantAlgo("filterkruskal");
+    if (wantMST && !symmetric) {
+        cerr << "Skipped Prim/Boruvka/FilterKruskal on " << graphClass << " " << graphType
+             << ": directed graph (MSTs need every arc's reverse)\n";
+        wantMST = false;
+    }
+    int refTotal = 0;
+    if (wantMST) {
+        BinaryHeap<int> bh(n);
+        HeapTrace trace;
+        RecordingQueue<int> rec(bh, trace);
+        vector<int> minEdge;
+        if (opts.traceDir.empty()) Algorithms::runPrim(g, 0, bh, minEdge, refTotal);
+        else Algorithms::runPrim(g, 0, rec, minEdge, refTotal);
+        saveTrace(trace, opts, "Prim", graphClass, graphType, N);
+    }
+    if (wantMST && opts.wantAlgo("prim"))
+        addPrimCases(cases, g, csr, refTotal, opts);
+    if (wantMST && opts.wantAlgo("boruvka"))
+        addMSTEngineCase(cases, "Boruvka", g, csr, refTotal,
+            [](const auto& graph, int& w) { ParallelMST::runBoruvka(graph, 0, workerPool(), w); });
+    if (wantMST && opts.wantAlgo("filterkruskal"))
+        addMSTEngineCase(cases, "FilterKruskal", g, csr, refTotal,
+            [](const auto& graph, int& w) { ParallelMST::runFilterKruskal(graph, 0, workerPool(), w); });
+
+    measure(cases, opts, rng);
+
+    for (const BenchCase& c : cases) {
+        if (!c.skipped.empty()) {
+            cerr << "Skipped " << c.algo << " heap=" << c.heap << " on " << graphClass << " " << graphType
+                 << " N=" << N << ": " << c.skipped << "\n";
+            continue;
+        }
+        results.write(c, graphClass, graphType, N);
+        writeRunStats(files, c.firstHeap.get(), c.algo, c.heap, graphClass, graphType, N);
+        if (!c.ok)
+            cerr << "Correctness warning: " << c.algo << " "
+                 << (string(c.algo) == "Dijkstra" ? "dist" : "total weight") << " mismatch for " << graphClass
+                 << " " << graphType << " N=" << N << " heap=" << c.heap << "\n";
+    }
+}
+
+// graphs depend only on the seed, type and size, not on which other cells are selected
+static unsigned cellSeed(unsigned seed, const char* graphType, int N) {
+    unsigned h = 2166136261u;
+    for (const char* p = graphType; *p; p++)
+        h = (h ^ (unsigned char)*p) * 16777619u;
+    return seed ^ h ^ ((unsigned)N * 2654435761u);
+}
+
+// warmup + trials of one run; the sweep files report the median
+template <typename F>
+static TrialStats timeTrials(const BenchOptions& opts, F run) {
+    vector<double> times;
+    for (int i = -opts.warmup; i < opts.trials; i++) {
+        auto t0 = Clock::now();
+        run();
+        double t = elapsedUs(t0);
+        if (i >= 0) times.push_back(t);
+    }
+    return TrialStats::of(times);
+}
+
+// thread counts for scaling runs: 1, 2, 4, ... and the hardware thread count
+static vector<int> scalingThreadCounts() {
+    int hw = ThreadPool::hardwareThreads();
+    vector<int> counts;
+    for (int t = 1; t < hw; t *= 2)
+        counts.push_back(t);
+    counts.push_back(hw);
+    return counts;
+}
+
+// multi-source batch dijkstra on 1..hw threads (batch_scaling.txt)
+template <template <typename> class H>
+static void runBatchScaling(const Graph& g, const char* heapName, const char* graphClass,
+                            const char* graphType, const BenchOptions& opts, ostream& out) {
+    const int numSources = 32;
     int n = g.numVertices;
+    vector<int> sources(numSources);
+    for (int i = 0; i < numSources; i++)
+        sources[i] = (int)((long)i * n / numSources);
 
+    vector<int> dist;
+    double baseUs = 0;
+    for (int threads : scalingThreadCounts()) {
+        ThreadPool pool(threads);
+        BatchDijkstra<H<int>> engine(g, pool);
+        TrialStats t = timeTrials(opts, [&] { engine.run(sources, dist); });
+        if (threads == 1) baseUs = t.medianUs;
+        char speedup[32];
+        snprintf(speedup, sizeof(speedup), "%.2f", t.medianUs > 0 ? baseUs / t.medianUs : 0.0);
+        out << graphClass << "," << graphType << "," << n << "," << heapName << "," << threads << ","
+            << numSources << "," << us(t.medianUs) << "," << speedup << "," << us(t.ci95Us) << "\n";
+    }
+
+    // spot-check the last row against a single-source run
+    vector<int> check;
     BinaryHeap<int> bh(n);
-    auto t0 = chrono::high_resolution_clock::now();
-    Algorithms::runPrim(g, 0, &bh, minEdgeB, totalB);
-    auto t1 = chrono::high_resolution_clock::now();
-    long usB = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
-    long opsB = bh.getOperationCount();
-
-    PairingHeap<int> ph(n);
-    t0 = chrono::high_resolution_clock::now();
-    Algorithms::runPrim(g, 0, &ph, minEdgeP, totalP);
-    t1 = chrono::high_resolution_clock::now();
-    long usP = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
-    long opsP = ph.getOperationCount();
-
-    FibonacciHeap<int> fh(n);
-    t0 = chrono::high_resolution_clock::now();
-    Algorithms::runPrim(g, 0, &fh, minEdgeF, totalF);
-    t1 = chrono::high_resolution_clock::now();
-    long usF = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
-    long opsF = fh.getOperationCount();
-
-    writeLine(out, log, "Prim", "Binary", graphClass, graphType, N, usB, opsB);
-    writeLine(out, log, "Prim", "Pairing", graphClass, graphType, N, usP, opsP);
-    writeLine(out, log, "Prim", "Fibonacci", graphClass, graphType, N, usF, opsF);
-
-    if (totalB != totalP || totalP != totalF)
-        cerr << "Correctness warning: Prim total weight mismatch for " << graphClass << " " << graphType << " N=" << N
-             << " (Binary=" << totalB << " Pairing=" << totalP << " Fibonacci=" << totalF << ")\n";
-}
-
-int main() {
-    srand(42);
-
-    ofstream out("results.txt");
+    Algorithms::runDijkstra(g, sources[numSources - 1], bh, check);
+    if (!equal(check.begin(), check.end(), dist.begin() + (size_t)(numSources - 1) * n))
+        cerr << "Correctness warning: batch Dijkstra dist mismatch for " << graphClass << " " << graphType
+             << " N=" << n << " heap=" << heapName << "\n";
+}
+
+static void runBatchScaling(const Graph& g, const char* graphClass, const char* graphType,
+                            const BenchOptions& opts, ostream& out) {
+    runBatchScaling<BinaryHeap>(g, "Binary", graphClass, graphType, opts, out);
+    runBatchScaling<DaryHeap8>(g, "8-ary", graphClass, graphType, opts, out);
+    runBatchScaling<DialQueue>(g, "Dial", graphClass, graphType, opts, out);
+}
+
+// delta-stepping vs sequential dijkstra over a delta sweep (delta_stepping.txt); Best=1 marks the fastest delta
+static void runDeltaSweep(const Graph& g, const char* graphClass, const char* graphType,
+                          const BenchOptions& opts, ostream& out) {
+    const int deltas[] = { 1, 10, 25, 50, 100, 200, 1000 };
+    const int numDeltas = sizeof(deltas) / sizeof(deltas[0]);
+    int n = g.numVertices;
+    int threads = ThreadPool::hardwareThreads();
+
+    // both sides allocate their own state inside the timed region
+    vector<int> ref;
+    double dijkstraUs = timeTrials(opts, [&] {
+        BinaryHeap<int> bh(n);
+        Algorithms::runDijkstra(g, 0, bh, ref);
+    }).medianUs;
+
+    ThreadPool pool(threads);
+    TrialStats t[numDeltas];
+    int best = 0;
+    for (int i = 0; i < numDeltas; i++) {
+        vector<int> dist;
+        t[i] = timeTrials(opts, [&] { DeltaStepping::run(g, 0, deltas[i], pool, dist); });
+        if (t[i].medianUs < t[best].medianUs) best = i;
+        if (dist != ref)
+            cerr << "Correctness warning: delta-stepping dist mismatch for " << graphClass << " " << graphType
+                 << " N=" << n << " delta=" << deltas[i] << "\n";
+    }
+    for (int i = 0; i < numDeltas; i++) {
+        char speedup[32];
+        snprintf(speedup, sizeof(speedup), "%.2f", t[i].medianUs > 0 ? dijkstraUs / t[i].medianUs : 0.0);
+        out << graphClass << "," << graphType << "," << n << "," << threads << "," << deltas[i] << ","
+            << us(t[i].medianUs) << "," << us(dijkstraUs) << "," << speedup << "," << (i == best) << ","
+            << us(t[i].ci95Us) << "\n";
+    }
+}
+
+// s-t pairs for the point-to-point sweep; depend only on the seed and the graph
+static vector<pair<int, int>> queryPairs(int n, int count, uint64_t seed) {
+    CounterRNG rng(seed, 2);
+    vector<pair<int, int>> pairs(count);
+    for (int i = 0; i < count; i++) {
+        uint64_t r = rng.at(i);
+        pairs[i] = make_pair((int)CounterRNG::below((uint32_t)(r >> 32), (uint32_t)n),
+                             (int)CounterRNG::below((uint32_t)r, (uint32_t)n));
+    }
+    return pairs;
+}
+
+// total weight of a path (lightest parallel edge per hop), -1 if a hop is not an edge
+template <typename GraphT>
+static long long pathWeight(const GraphT& g, const vector<int>& path) {
+    long long total = 0;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        int best = -1;
+        for (const auto& e : g.neighbors(path[i]))
+            if (e.target == path[i + 1] && (best < 0 || e.weight < best)) best = e.weight;
+        if (best < 0) return -1;
+        total += best;
+    }
+    return total;
+}
+
+// heaviest arc, 0 for an edgeless graph
+template <typename GraphT>
+static int maxArcWeight(const GraphT& g) {
+    int best = 0;
+    for (int u = 0; u < g.numVertices; u++)
+        for (const auto& e : g.neighbors(u))
+            if (e.weight > best) best = e.weight;
+    return best;
+}
+
+// the same s-t pairs three ways on one heap (point_to_point.txt): full sssp from s,
+// early exit once t is settled, bidirectional. Settled = mean vertices settled per
+// query (both sides for bidirectional), SpeedUp = full time / mode time. distances
+// must agree with the full search and the returned paths must add up to them.
+template <template <typename> class H, typename GraphT, typename ReverseT>
+static void runPointToPoint(const GraphT& g, const ReverseT& reverse, const vector<pair<int, int>>& pairs,
+                            const char* heapName, const char* graphClass, const char* graphType,
+                            const BenchOptions& opts, ostream& out) {
+    enum { FULL, EARLY_EXIT, BIDIRECTIONAL, NUM_MODES };
+    const char* const modeNames[NUM_MODES] = { "full", "early_exit", "bidirectional" };
+    int n = g.numVertices;
+    int numPairs = (int)pairs.size();
+    QueryWorkspace<H<int>> fwd(n), bwd(n);
+    TrialStats t[NUM_MODES];
+    long long settled[NUM_MODES];
+    vector<int> dist[NUM_MODES];
+    bool pathsOk = true;
+
+    auto query = [&](int mode, int i) {
+        int s = pairs[i].first, target = pairs[i].second, meet;
+        if (mode == FULL) {
+            Algorithms::runDijkstra(g, s, fwd);
+            dist[mode][i] = fwd.dist(target);
+            settled[mode] += fwd.settledCount();
+        } else if (mode == EARLY_EXIT) {
+            dist[mode][i] = Algorithms::runPointToPoint(g, s, target, fwd);
+            settled[mode] += fwd.settledCount();
+        } else {
+            dist[mode][i] = Algorithms::runBidirectional(g, reverse, s, target, fwd, bwd, meet);
+            settled[mode] += fwd.settledCount() + bwd.settledCount();
+        }
+    };
+
+    for (int m = 0; m < NUM_MODES; m++) {
+        dist[m].assign(numPairs, INF);
+        t[m] = timeTrials(opts, [&] {
+            settled[m] = 0;
+            for (int i = 0; i < numPairs; i++) query(m, i);
+        });
+        if (dist[m] != dist[FULL])
+            cerr << "Correctness warning: " << modeNames[m] << " s-t dist mismatch for " << graphClass << " "
+                 << graphType << " N=" << n << " heap=" << heapName << "\n";
+    }
+
+    // untimed path check
+    vector<int> path;
+    for (int i = 0; i < numPairs; i++) {
+        int s = pairs[i].first, target = pairs[i].second, meet;
+        int d = Algorithms::runPointToPoint(g, s, target, fwd);
+        if (d != INF && (!fwd.pathTo(target, path) || pathWeight(g, path) != d)) pathsOk = false;
+        d = Algorithms::runBidirectional(g, reverse, s, target, fwd, bwd, meet);
+        if (d != INF && (!Algorithms::bidirectionalPath(fwd, bwd, meet, path) || path.front() != s ||
+                         path.back() != target || pathWeight(g, path) != d))
+            pathsOk = false;
+    }
+    if (!pathsOk)
+        cerr << "Correctness warning: s-t path does not match dist for " << graphClass << " " << graphType
+             << " N=" << n << " heap=" << heapName << "\n";
+
+    for (int m = 0; m < NUM_MODES; m++) {
+        char perQuery[32], meanSettled[32], speedup[32];
+        snprintf(perQuery, sizeof(perQuery), "%.2f", t[m].medianUs / numPairs);
+        snprintf(meanSettled, sizeof(meanSettled), "%.1f", (double)settled[m] / numPairs);
+        snprintf(speedup, sizeof(speedup), "%.2f", t[m].medianUs > 0 ? t[FULL].medianUs / t[m].medianUs : 0.0);
+        out << graphClass << "," << graphType << "," << n << "," << heapName << "," << modeNames[m] << ","
+            << numPairs << "," << us(t[m].medianUs) << "," << perQuery << "," << meanSettled << "," << speedup
+            << "," << us(t[m].ci95Us) << "\n";
+    }
+}
+
+template <typename GraphT, typename ReverseT>
+static void runPointToPoint(const GraphT& g, const ReverseT& reverse, const char* graphClass, const char* graphType,
+                            const BenchOptions& opts, ostream& out) {
+    const int numPairs = 64;
+    vector<pair<int, int>> pairs = queryPairs(g.numVertices, numPairs, cellSeed(opts.seed, graphType, g.numVertices));
+    runPointToPoint<BinaryHeap>(g, reverse, pairs, "Binary", graphClass, graphType, opts, out);
+    runPointToPoint<PairingHeap>(g, reverse, pairs, "Pairing", graphClass, graphType, opts, out);
+    runPointToPoint<DaryHeap8>(g, reverse, pairs, "8-ary", graphClass, graphType, opts, out);
+    // a default DialQueue covers weights up to 100 and throws past that (as in the results matrix)
+    if (maxArcWeight(g) <= 100)
+        runPointToPoint<DialQueue>(g, reverse, pairs, "Dial", graphClass, graphType, opts, out);
+    else
+        cerr << "Skipped Dial s-t queries on " << graphClass << " " << graphType << ": edge weights above 100\n";
+}
+
+// ALT preprocessing and A* queries vs early-exit dijkstra on the same s-t pairs (alt.txt),
+// per landmark selection and count. PreprocessUS: one build (median over the trials);
+// TableBytes: landmark distance tables; Settled: mean per query; SpeedUp = DijkstraUS / ALTUS.
+template <template <typename> class H, typename GraphT>
+static void runALTQueries(const GraphT& g, const ALT& alt, double preprocessUs, const vector<pair<int, int>>& pairs,
+                          const char* heapName, const char* selection, const char* graphClass, const char* graphType,
+                          const BenchOptions& opts, ostream& out) {
+    int n = g.numVertices;
+    int numPairs = (int)pairs.size();
+    QueryWorkspace<H<int>> ws(n);
+    vector<int> ref(numPairs), dist(numPairs);
+    long long refSettled = 0, altSettled = 0;
+    TrialStats dijkstra = timeTrials(opts, [&] {
+        refSettled = 0;
+        for (int i = 0; i < numPairs; i++) {
+            ref[i] = Algorithms::runPointToPoint(g, pairs[i].first, pairs[i].second, ws);
+            refSettled += ws.settledCount();
+        }
+    });
+    TrialStats t = timeTrials(opts, [&] {
+        altSettled = 0;
+        for (int i = 0; i < numPairs; i++) {
+            dist[i] = alt.query(g, pairs[i].first, pairs[i].second, ws);
+            altSettled += ws.settledCount();
+        }
+    });
+
+    // untimed path check
+    bool ok = dist == ref;
+    vector<int> path;
+    for (int i = 0; i < numPairs && ok; i++) {
+        int d = alt.query(g, pairs[i].first, pairs[i].second, ws);
+        if (d != INF && (!ws.pathTo(pairs[i].second, path) || pathWeight(g, path) != d)) ok = false;
+    }
+    if (!ok)
+        cerr << "Correctness warning: ALT s-t dist/path mismatch for " << graphClass << " " << graphType << " N=" << n
+             << " landmarks=" << alt.k << " " << selection << " heap=" << heapName << "\n";
+
+    char dijkstraSettled[32], settled[32], speedup[32];
+    snprintf(dijkstraSettled, sizeof(dijkstraSettled), "%.1f", (double)refSettled / numPairs);
+    snprintf(settled, sizeof(settled), "%.1f", (double)altSettled / numPairs);
+    snprintf(speedup, sizeof(speedup), "%.2f", t.medianUs > 0 ? dijkstra.medianUs / t.medianUs : 0.0);
+    out << graphClass << "," << graphType << "," << n << "," << selection << "," << alt.k << ","
+        << us(preprocessUs) << "," << alt.tableBytes() << "," << heapName << "," << numPairs << ","
+        << us(dijkstra.medianUs) << "," << us(t.medianUs) << "," << dijkstraSettled << "," << settled << ","
+        << speedup << "," << us(t.ci95Us) << "\n";
+}
+
+template <typename GraphT, typename ReverseT>
+static void runALTSweep(const GraphT& g, const ReverseT& reverse, const char* graphClass, const char* graphType,
+                        const BenchOptions& opts, ostream& out) {
+    const int numPairs = 64;
+    const int landmarkCounts[] = { 4, 8, 16 };
+    const ALT::Selection selections[] = { ALT::FARTHEST, ALT::AVOID };
+    uint64_t seed = cellSeed(opts.seed, graphType, g.numVertices);
+    vector<pair<int, int>> pairs = queryPairs(g.numVertices, numPairs, seed);
+    for (ALT::Selection sel : selections) {
+        for (int k : landmarkCounts) {
+            unique_ptr<ALT> alt;
+            double preprocessUs = timeTrials(opts, [&] { alt.reset(new ALT(g, reverse, k, sel, seed)); }).medianUs;
+            const char* name = ALT::selectionName(sel);
+            runALTQueries<BinaryHeap>(g, *alt, preprocessUs, pairs, "Binary", name, graphClass, graphType, opts, out);
+            runALTQueries<PairingHeap>(g, *alt, preprocessUs, pairs, "Pairing", name, graphClass, graphType, opts, out);
+            runALTQueries<DaryHeap8>(g, *alt, preprocessUs, pairs, "8-ary", name, graphClass, graphType, opts, out);
+        }
+    }
+}
+
+// nearest-rank percentile of sorted latencies
+static double percentile(const vector<double>& sorted, double q) {
+    return sorted.empty() ? 0 : sorted[(size_t)max(0.0, ceil(q * sorted.size()) - 1)];
+}
+
+// contraction hierarchy on one heap (ch.txt): PreprocessUS = one build with witness
+// searches on that heap (seconds on large graphs, so not repeated per trial);
+// per-query latencies of every timed round feed the percentiles. DijkstraUS / DijkstraSettled: mean early-exit query on
+// the same pairs; SpeedUp = DijkstraUS / MeanUS. distances must match runDijkstra.
+template <template <typename> class H, typename GraphT>
+static void runCHQueries(const GraphT& g, const vector<pair<int, int>>& pairs, const char* heapName,
+                         const char* graphClass, const char* graphType, const BenchOptions& opts, ostream& out) {
+    int n = g.numVertices;
+    int numPairs = (int)pairs.size();
+    QueryWorkspace<H<int>> fwd(n), bwd(n);
+    auto t0 = Clock::now();
+    unique_ptr<ContractionHierarchy> ch(new ContractionHierarchy(g, fwd));
+    double preprocessUs = elapsedUs(t0);
+
+    vector<int> dist(numPairs);
+    vector<double> latency;
+    long long settled = 0;
+    for (int round = -opts.warmup; round < opts.trials; round++) {
+        settled = 0;
+        for (int i = 0; i < numPairs; i++) {
+            auto q0 = Clock::now();
+            dist[i] = ch->query(pairs[i].first, pairs[i].second, fwd, bwd);
+            double t = elapsedUs(q0);
+            settled += fwd.settledCount() + bwd.settledCount();
+            if (round >= 0) latency.push_back(t);
+        }
+    }
+    sort(latency.begin(), latency.end());
+    double meanUs = 0;
+    for (double t : latency) meanUs += t;
+    meanUs = latency.empty() ? 0 : meanUs / latency.size();
+
+    long long refSettled = 0;
+    TrialStats dijkstra = timeTrials(opts, [&] {
+        refSettled = 0;
+        for (int i = 0; i < numPairs; i++) {
+            Algorithms::runPointToPoint(g, pairs[i].first, pairs[i].second, fwd);
+            refSettled += fwd.settledCount();
+        }
+    });
+    double dijkstraUs = dijkstra.medianUs / numPairs;
+
+    // untimed check against full searches
+    bool ok = true;
+    for (int i = 0; i < numPairs && ok; i++) {
+        Algorithms::runDijkstra(g, pairs[i].first, fwd);
+        if (fwd.dist(pairs[i].second) != dist[i]) ok = false;
+    }
+    if (!ok)
+        cerr << "Correctness warning: CH s-t dist mismatch for " << graphClass << " " << graphType << " N=" << n
+             << " heap=" << heapName << "\n";
+
+    char meanSettled[32], refMeanSettled[32], speedup[32];
+    snprintf(meanSettled, sizeof(meanSettled), "%.1f", (double)settled / numPairs);
+    snprintf(refMeanSettled, sizeof(refMeanSettled), "%.1f", (double)refSettled / numPairs);
+    snprintf(speedup, sizeof(speedup), "%.2f", meanUs > 0 ? dijkstraUs / meanUs : 0.0);
+    out << graphClass << "," << graphType << "," << n << "," << heapName << "," << us(preprocessUs) << ","
+        << ch->numShortcuts << "," << ch->searchGraphBytes() << "," << numPairs << "," << us(meanUs) << ","
+        << us(percentile(latency, 0.5)) << "," << us(percentile(latency, 0.9)) << ","
+        << us(percentile(latency, 0.99)) << "," << us(latency.empty() ? 0 : latency.back()) << "," << meanSettled
+        << "," << us(dijkstraUs) << "," << refMeanSettled << "," << speedup << "\n";
+}
+
+// dial is left out: shortcut weights exceed its bucket range
+template <typename GraphT>
+static void runCHSweep(const GraphT& g, const char* graphClass, const char* graphType, const BenchOptions& opts,
+                       ostream& out) {
+    const int numPairs = 1000;
+    vector<pair<int, int>> pairs = queryPairs(g.numVertices, numPairs, cellSeed(opts.seed, graphType, g.numVertices));
+    runCHQueries<BinaryHeap>(g, pairs, "Binary", graphClass, graphType, opts, out);
+    runCHQueries<PairingHeap>(g, pairs, "Pairing", graphClass, graphType, opts, out);
+    runCHQueries<DaryHeap8>(g, pairs, "8-ary", graphClass, graphType, opts, out);
+}
+
+// one batch of random updates in equal parts: reweight an existing edge, insert an
+// edge between random vertices (or reweight it if present), delete an existing edge.
+// existing edges are drawn as a random arc of a random vertex; draw advances the stream.
+static vector<EdgeUpdate> randomUpdates(const DynamicGraph& g, int count, const CounterRNG& rng, uint64_t& draw) {
+    uint32_t n = (uint32_t)g.numVertices;
+    vector<EdgeUpdate> updates;
+    for (int i = 0; i < count; i++) {
+        uint64_t r = rng.at(draw++);
+        int kind = (int)CounterRNG::below((uint32_t)rng.at(draw++), 3);
+        int weight = 1 + (int)CounterRNG::below((uint32_t)(r >> 32), 100);
+        int u = (int)CounterRNG::below((uint32_t)r, n);
+        if (kind == 1) {
+            updates.push_back({ u, (int)CounterRNG::below((uint32_t)rng.at(draw++), n), weight });
+            continue;
+        }
+        for (int tries = 0; g.neighbors(u).empty() && tries < 16; tries++)
+            u = (int)CounterRNG::below((uint32_t)rng.at(draw++), n);
+        const vector<Edge>& arcs = g.neighbors(u);
+        if (arcs.empty()) continue;
+        int v = arcs[CounterRNG::below((uint32_t)rng.at(draw++), (uint32_t)arcs.size())].target;
+        updates.push_back({ u, v, kind == 0 ? weight : EdgeUpdate::DELETE });
+    }
+    return updates;
+}
+
+// incremental sssp + mst under batches of edge updates vs rerunning dijkstra and prim
+// on the updated graph (dynamic.txt). each (heap, batch size) starts a fresh engine on
+// the same graph and update stream; updates change the graph, so every batch runs
+// once and times are means over the batches. after each batch distances, parents and
+// the forest weight must match the full recomputation.
+template <template <typename> class H, typename GraphT>
+static void runDynamicUpdates(const GraphT& g, int batchSize, int numBatches, const char* heapName,
+                              const char* graphClass, const char* graphType, uint64_t seed, ostream& out) {
+    int n = g.numVertices;
+    DynamicEngine<H<int>> engine(g, true, 0);
+    CounterRNG rng(seed, 4);
+    uint64_t draw = 0;
+    double updateUs = 0, dijkstraUs = 0, primUs = 0;
+    long long relabelled = 0, treeChanges = 0, applied = 0;
+    bool ok = true;
+    vector<int> dist, minEdge;
+    for (int b = 0; b < numBatches; b++) {
+        vector<EdgeUpdate> updates = randomUpdates(engine.graph, batchSize, rng, draw);
+        applied += (long long)updates.size();
+        auto t0 = Clock::now();
+        auto stats = engine.applyBatch(updates);
+        updateUs += elapsedUs(t0);
+        relabelled += stats.relabelled;
+        treeChanges += stats.treeChanges;
+
+        H<int> dijkstraHeap(n), primHeap(n);
+        t0 = Clock::now();
+        Algorithms::runDijkstra(engine.graph, 0, dijkstraHeap, dist);
+        dijkstraUs += elapsedUs(t0);
+        int primTotal;
+        t0 = Clock::now();
+        Algorithms::runPrim(engine.graph, 0, primHeap, minEdge, primTotal);
+        primUs += elapsedUs(t0);
+
+        const vector<int>& d = engine.sssp.distances();
+        if (d != dist || engine.mst->treeWeight(0) != primTotal) ok = false;
+        for (int v = 0; v < n && ok; v++) {
+            int p = engine.sssp.parentOf(v);
+            if (v != 0 && d[v] != INF && (p < 0 || d[p] + engine.graph.weight(p, v) != d[v])) ok = false;
+        }
+    }
+    if (!ok)
+        cerr << "Correctness warning: dynamic sssp/mst mismatch for " << graphClass << " " << graphType
+             << " N=" << n << " batch=" << batchSize << " heap=" << heapName << "\n";
+
+    char perUpdate[32], meanRelabelled[32], meanTreeChanges[32], speedup[32];
+    double batchUs = updateUs / numBatches, fullUs = (dijkstraUs + primUs) / numBatches;
+    snprintf(perUpdate, sizeof(perUpdate), "%.2f", applied > 0 ? updateUs / applied : 0.0);
+    snprintf(meanRelabelled, sizeof(meanRelabelled), "%.1f", (double)relabelled / numBatches);
+    snprintf(meanTreeChanges, sizeof(meanTreeChanges), "%.1f", (double)treeChanges / numBatches);
+    snprintf(speedup, sizeof(speedup), "%.2f", batchUs > 0 ? fullUs / batchUs : 0.0);
+    out << graphClass << "," << graphType << "," << n << "," << heapName << "," << batchSize << "," << numBatches
+        << "," << us(batchUs) << "," << perUpdate << "," << meanRelabelled << "," << meanTreeChanges << ","
+        << us(dijkstraUs / numBatches) << "," << us(primUs / numBatches) << "," << speedup << "\n";
+}
+
+template <typename GraphT>
+static void runDynamicSweep(const GraphT& g, const char* graphClass, const char* graphType, const BenchOptions& opts,
+                            ostream& out) {
+    const int batchSizes[] = { 1, 10, 100, 1000 };
+    const int numBatches = 20;
+    uint64_t seed = cellSeed(opts.seed, graphType, g.numVertices);
+    for (int size : batchSizes) {
+        runDynamicUpdates<BinaryHeap>(g, size, numBatches, "Binary", graphClass, graphType, seed, out);
+        runDynamicUpdates<PairingHeap>(g, size, numBatches, "Pairing", graphClass, graphType, seed, out);
+        runDynamicUpdates<DaryHeap8>(g, size, numBatches, "8-ary", graphClass, graphType, seed, out);
+    }
+}
+
+// forwards to a heap and counts what the algorithm asked of it: inserts, decreaseKeys,
+// extracts and the most entries queued at once (decreaseKey only instantiated for the
+// decreaseKey mode, so insert-only heaps fit too)
+template <typename PQ>
+struct CountingQueue {
+    PQ heap;
+    long inserts, decreaseKeys, extracts;
+    long size, peak;
+
+    explicit CountingQueue(int n) : heap(n), inserts(0), decreaseKeys(0), extracts(0), size(0), peak(0) {}
+
+    void insert(int key, int value) {
+        heap.insert(key, value);
+        inserts++;
+        peak = max(peak, ++size);
+    }
+
+    bool extractMin(int& key, int& value) {
+        if (!heap.extractMin(key, value)) return false;
+        extracts++;
+        size--;
+        return true;
+    }
+
+    void decreaseKey(int value, int newKey) {
+        heap.decreaseKey(value, newKey);
+        decreaseKeys++;
+    }
+
+    bool isEmpty() const { return heap.isEmpty(); }
+};
+
+// dijkstra (dist) or prim (minEdge, total) from vertex 0, decreaseKey or lazy-deletion mode
+template <bool LAZY, typename GraphT, typename PQ>
+static void runQueueMode(const GraphT& g, bool prim, PQ& pq, vector<int>& result, int& total) {
+    if constexpr (LAZY) {
+        if (prim) Algorithms::runPrimLazy(g, 0, pq, result, total);
+        else Algorithms::runDijkstraLazy(g, 0, pq, result);
+    } else {
+        if (prim) Algorithms::runPrim(g, 0, pq, result, total);
+        else Algorithms::runDijkstra(g, 0, pq, result);
+    }
+}
+
+// one lazy.txt row: the heap is built inside the timed region (the position map is
+// part of what the decreaseKey mode pays for); counts come from one extra untimed run
+// through CountingQueue. StaleExtracts = entries extracted for vertices already done.
+// baseUs: the decreaseKey Binary time of the same algorithm, set by its own row.
+template <template <typename> class H, bool LAZY, typename GraphT>
+static void runQueueModeRow(const GraphT& g, bool prim, const vector<int>& refDist, int refTotal, const char* heapName,
+                            const char* graphClass, const char* graphType, const BenchOptions& opts, double& baseUs,
+                            ostream& out) {
+    int n = g.numVertices;
+    vector<int> result;
+    int total = 0;
+    TrialStats t = timeTrials(opts, [&] {
+        H<int> pq(n);
+        runQueueMode<LAZY>(g, prim, pq, result, total);
+    });
+    if (baseUs == 0) baseUs = t.medianUs;
+
+    CountingQueue<H<int>> counter(n);
+    runQueueMode<LAZY>(g, prim, counter, result, total);
+    long reached = (long)count_if(result.begin(), result.end(), [](int d) { return d != INF; });
+    if (prim ? total != refTotal : result != refDist)
+        cerr << "Correctness warning: " << (LAZY ? "lazy " : "") << (prim ? "Prim total" : "Dijkstra dist")
+             << " mismatch for " << graphClass << " " << graphType << " N=" << n << " heap=" << heapName << "\n";
+
+    char speedup[32];
+    snprintf(speedup, sizeof(speedup), "%.2f", t.medianUs > 0 ? baseUs / t.medianUs : 0.0);
+    out << graphClass << "," << graphType << "," << n << "," << (prim ? "Prim" : "Dijkstra") << "," << heapName
+        << "," << (LAZY ? "lazy" : "decrease_key") << "," << us(t.medianUs) << "," << counter.inserts << ","
+        << counter.decreaseKeys << "," << counter.extracts - reached << "," << counter.peak << "," << speedup << ","
+        << us(t.ci95Us) << "\n";
+}
+
+// decreaseKey vs lazy-deletion mode for dijkstra and prim from vertex 0 (lazy.txt):
+// the position-map heaps in both modes, the insert-only heaps (LazyHeap.h, PackedLazyHeap) lazily
+template <typename GraphT>
+static void runLazySweep(const GraphT& g, const char* graphClass, const char* graphType, const BenchOptions& opts,
+                         ostream& out) {
+    int n = g.numVertices;
+    vector<int> refDist, minEdge;
+    int refTotal = 0;
+    BinaryHeap<int> dijkstraHeap(n), primHeap(n);
+    Algorithms::runDijkstra(g, 0, dijkstraHeap, refDist);
+    Algorithms::runPrim(g, 0, primHeap, minEdge, refTotal);
+
+    for (bool prim : { false, true }) {
+        double baseUs = 0;
+        runQueueModeRow<BinaryHeap, false>(g, prim, refDist, refTotal, "Binary", graphClass, graphType, opts, baseUs,
+                                           out);
+        runQueueModeRow<DaryHeap4, false>(g, prim, refDist, refTotal, "4-ary", graphClass, graphType, opts, baseUs,
+                                          out);
+        runQueueModeRow<PairingHeap, false>(g, prim, refDist, refTotal, "Pairing", graphClass, graphType, opts,
+                                            baseUs, out);
+        runQueueModeRow<BinaryHeap, true>(g, prim, refDist, refTotal, "Binary", graphClass, graphType, opts, baseUs,
+                                          out);
+        runQueueModeRow<PairingHeap, true>(g, prim, refDist, refTotal, "Pairing", graphClass, graphType, opts,
+                                           baseUs, out);
+        runQueueModeRow<QuadLazyHeap, true>(g, prim, refDist, refTotal, "4-ary-implicit", graphClass, graphType, opts,
+                                            baseUs, out);
+        runQueueModeRow<StdLazyHeap, true>(g, prim, refDist, refTotal, "StdPQ", graphClass, graphType, opts, baseUs,
+                                           out);
+        runQueueModeRow<PackedLazyHeap, true>(g, prim, refDist, refTotal, "4-ary-packed", graphClass, graphType, opts,
+                                              baseUs, out);
+    }
+}
+
+// dijkstra and prim from (original) vertex 0 on one relabelled graph, one row per
+// algorithm (reorder.txt); results are mapped back and checked against the original
+// numbering (the prim total only if refTotal is set). baseUs[algo]: the time on the original
+// numbering, set by its own rows.
+template <template <typename> class H>
+static void runReorderedRows(const CSRGraph& g, const Relabeling& relabel, const char* order, double reorderUs,
+                             double gap, const vector<int>& refDist, const int* refTotal, const char* heapName,
+                             const char* graphClass, const char* graphType, const BenchOptions& opts,
+                             double baseUs[2], ostream& out) {
+    int n = g.numVertices;
+    int source = relabel.newId[0];
+    vector<int> result, mapped;
+    int total = 0;
+    TrialStats t[2];
+    t[0] = timeTrials(opts, [&] {
+        H<int> pq(n);
+        Algorithms::runDijkstra(g, source, pq, result);
+    });
+    relabel.toOriginal(result, mapped);
+    bool ok = mapped == refDist;
+    t[1] = timeTrials(opts, [&] {
+        H<int> pq(n);
+        Algorithms::runPrim(g, source, pq, result, total);
+    });
+    ok = ok && (!refTotal || total == *refTotal);
+    if (!ok)
+        cerr << "Correctness warning: " << order << " reordering changed Dijkstra/Prim results for " << graphClass
+             << " " << graphType << " N=" << n << " heap=" << heapName << "\n";
+
+    const char* const algos[2] = { "Dijkstra", "Prim" };
+    for (int a = 0; a < 2; a++) {
+        if (baseUs[a] == 0) baseUs[a] = t[a].medianUs;
+        char meanGap[32], speedup[32];
+        snprintf(meanGap, sizeof(meanGap), "%.1f", gap);
+        snprintf(speedup, sizeof(speedup), "%.2f", t[a].medianUs > 0 ? baseUs[a] / t[a].medianUs : 0.0);
+        out << graphClass << "," << graphType << "," << n << "," << order << "," << us(reorderUs) << "," << meanGap
+            << "," << algos[a] << "," << heapName << "," << us(t[a].medianUs) << "," << speedup << ","
+            << us(t[a].ci95Us) << "\n";
+    }
+}
+
+// one keys.txt row: dijkstra from vertex 0 with D-typed distances on HeapT (keys D, or
+// packed int keys); EntryBytes = bytes a queued entry takes in the heap's arrays.
+// distances must match the int reference (no generated graph overflows int).
+template <typename HeapT, bool LAZY, typename D, typename GraphT>
+static void runKeyRow(const GraphT& g, const vector<int>& ref, const char* heapName, size_t entryBytes,
+                      const char* graphClass, const char* graphType, const BenchOptions& opts, double& baseUs,
+                      ostream& out) {
+    int n = g.numVertices;
+    vector<D> dist;
+    TrialStats t = timeTrials(opts, [&] {
+        HeapT pq(n);
+        if constexpr (LAZY) Algorithms::runDijkstraLazy(g, 0, pq, dist);
+        else Algorithms::runDijkstra(g, 0, pq, dist);
+    });
+    if (baseUs == 0) baseUs = t.medianUs;
+    bool ok = true;
+    for (int v = 0; v < n && ok; v++)
+        ok = dist[v] == numeric_limits<D>::max() ? ref[v] == INF : dist[v] == (D)ref[v];
+    if (!ok)
+        cerr << "Correctness warning: " << 8 * sizeof(D) << "-bit key Dijkstra dist mismatch for " << graphClass << " "
+             << graphType << " N=" << n << " heap=" << heapName << "\n";
+
+    char speedup[32];
+    snprintf(speedup, sizeof(speedup), "%.2f", t.medianUs > 0 ? baseUs / t.medianUs : 0.0);
+    out << graphClass << "," << graphType << "," << n << "," << heapName << "," << (LAZY ? "lazy" : "decrease_key")
+        << "," << 8 * sizeof(D) << "," << entryBytes << "," << us(t.medianUs) << "," << speedup << ","
+        << us(t.ci95Us) << "\n";
+}
+
+// int vs long long distance keys vs packed int keys, dijkstra only (keys.txt)
+template <typename GraphT>
+static void runKeySweep(const GraphT& g, const char* graphClass, const char* graphType, const BenchOptions& opts,
+                        ostream& out) {
+    vector<int> ref;
+    BinaryHeap<int> bh(g.numVertices);
+    Algorithms::runDijkstra(g, 0, bh, ref);
+    double baseUs = 0;
+    runKeyRow<BinaryHeap<int>, false, int>(g, ref, "Binary", sizeof(pair<int, int>), graphClass, graphType, opts,
+                                           baseUs, out);
+    runKeyRow<BinaryHeap<int, long long>, false, long long>(g, ref, "Binary", sizeof(pair<long long, int>),
+                                                            graphClass, graphType, opts, baseUs, out);
+    runKeyRow<PackedBinaryHeap<int>, false, int>(g, ref, "Binary-packed", sizeof(uint64_t), graphClass, graphType,
+                                                 opts, baseUs, out);
+    runKeyRow<DaryHeap8<int>, false, int>(g, ref, "8-ary", sizeof(int) + sizeof(int), graphClass, graphType, opts,
+                                          baseUs, out);
+    runKeyRow<DaryHeap<int, 8, long long>, false, long long>(g, ref, "8-ary", sizeof(long long) + sizeof(int),
+                                                             graphClass, graphType, opts, baseUs, out);
+    runKeyRow<PackedDaryHeap8<int>, false, int>(g, ref, "8-ary-packed", sizeof(uint64_t), graphClass, graphType,
+                                                opts, baseUs, out);
+    runKeyRow<QuadLazyHeap<int>, true, int>(g, ref, "4-ary-implicit", sizeof(pair<int, int>), graphClass, graphType,
+                                            opts, baseUs, out);
+    runKeyRow<QuadLazyHeap<int, long long>, true, long long>(g, ref, "4-ary-implicit", sizeof(pair<long long, int>),
+                                                             graphClass, graphType, opts, baseUs, out);
+    runKeyRow<PackedLazyHeap<int>, true, int>(g, ref, "4-ary-packed", sizeof(uint64_t), graphClass, graphType, opts,
+                                              baseUs, out);
+}
+
+// every vertex ordering of one graph (CSR layout): ReorderUS = computing the order and
+// building the renumbered CSR (median over the trials); grid: rows x cols > 0 adds hilbert.
+// checkPrim false (directed files): prim is still timed, but its total depends on the
+// tie order, so only dijkstra is checked
+template <typename GraphT>
+static void runReorderSweep(const GraphT& g, int gridRows, int gridCols, bool checkPrim, const char* graphClass,
+                            const char* graphType, const BenchOptions& opts, ostream& out) {
+    int n = g.numVertices;
+    vector<int> refDist, minEdge;
+    int refTotal = 0;
+    BinaryHeap<int> dijkstraHeap(n), primHeap(n);
+    Algorithms::runDijkstra(g, 0, dijkstraHeap, refDist);
+    Algorithms::runPrim(g, 0, primHeap, minEdge, refTotal);
+
+    const VertexOrdering::Kind kinds[] = { VertexOrdering::ORIGINAL, VertexOrdering::BFS, VertexOrdering::RCM,
+                                           VertexOrdering::DEGREE, VertexOrdering::HILBERT };
+    const int* primRef = checkPrim ? &refTotal : nullptr;
+    double baseUs[3][2] = {};  // per heap, per algorithm
+    for (VertexOrdering::Kind kind : kinds) {
+        if (kind == VertexOrdering::HILBERT && gridRows * gridCols != n) continue;
+        Relabeling relabel = VertexOrdering::identity(n);
+        CSRGraph reordered;
+        auto build = [&] {
+            if (kind == VertexOrdering::BFS) relabel = VertexOrdering::bfs(g, 0);
+            else if (kind == VertexOrdering::RCM) relabel = VertexOrdering::rcm(g);
+            else if (kind == VertexOrdering::DEGREE) relabel = VertexOrdering::degree(g);
+            else if (kind == VertexOrdering::HILBERT) relabel = VertexOrdering::hilbert(gridRows, gridCols);
+            reordered = relabel.apply(g);
+        };
+        double reorderUs = kind == VertexOrdering::ORIGINAL ? 0 : timeTrials(opts, build).medianUs;
+        if (kind == VertexOrdering::ORIGINAL) reordered = relabel.apply(g);  // plain copy (mapped files too)
+        double gap = VertexOrdering::meanEdgeGap(reordered);
+        const char* order = VertexOrdering::name(kind);
+        runReorderedRows<BinaryHeap>(reordered, relabel, order, reorderUs, gap, refDist, primRef, "Binary",
+                                     graphClass, graphType, opts, baseUs[0], out);
+        runReorderedRows<PairingHeap>(reordered, relabel, order, reorderUs, gap, refDist, primRef, "Pairing",
+                                      graphClass, graphType, opts, baseUs[1], out);
+        runReorderedRows<DaryHeap8>(reordered, relabel, order, reorderUs, gap, refDist, primRef, "8-ary",
+                                    graphClass, graphType, opts, baseUs[2], out);
+    }
+}
+
+// sweep files the --graph inputs also write to, as the graphs come (files first,
+// generated families last)
+struct FileSweeps {
+    ofstream p2p;      // point_to_point.txt
+    ofstream alt;      // alt.txt
+    ofstream ch;       // ch.txt
+    ofstream reorder;  // reorder.txt
+};
+
+// one --graph file as a cell of class "file" named after its basename. .csrg files
+// are mapped and the mapping serves as the CSR layout; text formats are parsed
+// (edge lists as undirected, for prim) and copied to CSR like the generated graphs.
+// with sweep files, the point-to-point, ALT, CH and reorder sweeps run on the CSR layout
+// too. files may be directed: the reverse graph serves the backward searches and the
+// symmetry check that decides whether Prim and the MST engines run.
+static bool runGraphFile(const string& path, const BenchOptions& opts, mt19937& rng, ResultWriter& results,
+                         RunStatsFiles& files, FileSweeps* sweeps) {
+    string name = path.substr(path.find_last_of("/\\") + 1);
+    string ext = name.substr(min(name.size(), name.find_last_of('.')));
+    string error;
+    auto t0 = Clock::now();
+    if (ext == ".csrg") {
+        MappedCSRGraph mapped;
+        if (!mapped.open(path, error)) {
+            cerr << error << "\n";
+            return false;
+        }
+        double loadUs = elapsedUs(t0);
+        // the results matrix also times the adjacency-list layout, which needs a copy
+        auto t1 = Clock::now();
+        Graph g = GraphIO::toAdjacencyList(mapped);
+        cerr << "Mapped " << path << ": " << mapped.numVertices << " vertices, " << mapped.numEdges()
+             << " edges in " << us(loadUs) << " us (adjacency-list copy " << us(elapsedUs(t1)) << " us)\n";
+        CSRGraph reverse = reversedCSR(mapped);
+        bool symmetric = isSymmetric(mapped, reverse);
+        runCell(g, mapped, g.numVertices, "file", name.c_str(), opts, rng, results, files, symmetric);
+        if (sweeps) {
+            runPointToPoint(mapped, reverse, "file", name.c_str(), opts, sweeps->p2p);
+            runALTSweep(mapped, reverse, "file", name.c_str(), opts, sweeps->alt);
+            runCHSweep(mapped, "file", name.c_str(), opts, sweeps->ch);
+            runReorderSweep(mapped, 0, 0, symmetric, "file", name.c_str(), opts, sweeps->reorder);
+        }
+        return true;
+    }
+    Graph g(0);
+    bool ok = ext == ".gr" ? GraphIO::readDimacs(path, g, error) : GraphIO::readEdgeList(path, g, true, error);
+    if (!ok) {
+        cerr << error << "\n";
+        return false;
+    }
+    double loadUs = elapsedUs(t0);
+    CSRGraph csr(g);
+    cerr << "Parsed " << path << ": " << g.numVertices << " vertices, " << csr.numEdges() << " edges in "
+         << us(loadUs) << " us\n";
+    CSRGraph reverse = reversedCSR(csr);
+    bool symmetric = isSymmetric(csr, reverse);
+    runCell(g, csr, g.numVertices, "file", name.c_str(), opts, rng, results, files, symmetric);
+    if (sweeps) {
+        runPointToPoint(csr, reverse, "file", name.c_str(), opts, sweeps->p2p);
+        runALTSweep(csr, reverse, "file", name.c_str(), opts, sweeps->alt);
+        runCHSweep(csr, "file", name.c_str(), opts, sweeps->ch);
+        runReorderSweep(csr, 0, 0, symmetric, "file", name.c_str(), opts, sweeps->reorder);
+    }
+    return true;
+}
+
+// opens one sweep file and writes its csv header; false (after a message) if it can't
+static bool openSweepFile(ofstream& out, const char* path, const char* header) {
+    out.open(path);
     if (!out) {
-        cerr << "Could not open results.txt for writing.\n";
+        cerr << "Could not open " << path << " for writing.\n";
+        return false;
+    }
+    out << header;
+    return true;
+}
+
+// unknown names in a selection list are an error rather than an empty run
+static bool checkNames(const vector<string>& list, const char* const* known, int numKnown, const char* what) {
+    for (const string& name : list) {
+        bool found = false;
+        for (int i = 0; i < numKnown; i++)
+            if (BenchOptions::sameName(name, known[i])) found = true;
+        if (!found) {
+            cerr << "unknown " << what << " " << name << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    string error;
+    if (!opts.parse(argc, argv, error)) {
+        if (error == "help") {
+            BenchOptions::usage(cout, argv[0]);
+            return 0;
+        }
+        cerr << error << "\n";
+        BenchOptions::usage(cerr, argv[0]);
         return 1;
     }
+    const char* heapNames[numHeaps];
+    for (int h = 0; h < numHeaps; h++)
+        heapNames[h] = heapColumns[h].name;
+    if (!checkNames(opts.algos, algoNames, sizeof(algoNames) / sizeof(algoNames[0]), "algorithm") ||
+        !checkNames(opts.heaps, heapNames, numHeaps, "heap") ||
+        !checkNames(opts.classes, classNames, sizeof(classNames) / sizeof(classNames[0]), "graph class"))
+        return 1;
 
-    const char* header = "Algo,HeapType,GraphClass,GraphType,N,TimeUS,Ops\n";
-    out << header;
-    cout << header;
+    ofstream out(opts.outPath);
+    if (!out) {
+        cerr << "Could not open " << opts.outPath << " for writing.\n";
+        return 1;
+    }
 
-    const int smallSizes[] = { 100, 500 };
-    const int largeSizes[] = { 5000, 10000 };
-    const int numSmall = sizeof(smallSizes) / sizeof(smallSizes[0]);
-    const int numLarge = sizeof(largeSizes) / sizeof(largeSizes[0]);
+    RunStatsFiles files;
+    files.fib.open("fib_stats.txt");
+    if (!files.fib) {
+        cerr << "Could not open fib_stats.txt for writing.\n";
+        return 1;
+    }
+    files.fib << "Algo,GraphClass,GraphType,N,Extracts,Links,Cuts,LinksPerExtract\n";
+#ifdef HEAP_STATS
+    string outDir = opts.outPath.substr(0, opts.outPath.find_last_of("/\\") + 1);
+    files.ops.open(outDir + "heap_stats.txt");
+    files.histograms.open(outDir + "heap_histograms.txt");
+    if (!files.ops || !files.histograms) {
+        cerr << "Could not open heap_stats.txt / heap_histograms.txt in '" << outDir << "' for writing.\n";
+        return 1;
+    }
+    files.ops << "Algo,HeapType,GraphClass,GraphType,N,Op,Calls,Comparisons,Moves,P50NS,P90NS,P99NS,MaxNS,"
+                 "ExtractShapeMean,ExtractShapeMax\n";
+    files.histograms << "Algo,HeapType,GraphClass,GraphType,N,Op,BucketLowNS,Count\n";
+#endif
 
-    // random sparse/dense
-    for (int i = 0; i < numSmall; i++) {
-        int N = smallSizes[i];
-        Graph sparse(N);
-        generateRandomSparse(sparse, 5);
-        Graph dense(N);
-        generateRandomDense(dense, 0.15);
-        runDijkstra(sparse, N, "random", "sparse", out, cout);
-        runPrim(sparse, N, "random", "sparse", out, cout);
-        runDijkstra(dense, N, "random", "dense", out, cout);
-        runPrim(dense, N, "random", "dense", out, cout);
-    }
-    for (int i = 0; i < numLarge; i++) {
-        int N = largeSizes[i];
-        Graph sparse(N);
-        generateRandomSparse(sparse, 5);
-        Graph dense(N);
-        generateRandomDense(dense, 0.15);
-        runDijkstra(sparse, N, "random", "sparse", out, cout);
-        runPrim(sparse, N, "random", "sparse", out, cout);
-        runDijkstra(dense, N, "random", "dense", out, cout);
-        runPrim(dense, N, "random", "dense", out, cout);
-    }
-
-    // grids
-    auto runGrid = [&](int rows, int cols) {
-        int N = rows * cols;
-        Graph g(N);
-        generateGrid(g, rows, cols);
-        char typeBuf[32];
-        snprintf(typeBuf, sizeof(typeBuf), "grid_%dx%d", rows, cols);
-        runDijkstra(g, N, "grid", typeBuf, out, cout);
-        runPrim(g, N, "grid", typeBuf, out, cout);
+    if (!perfCounters().available())
+        cerr << "Hardware counters unavailable (perf_event_open denied or no PMU); counter columns left empty.\n";
+
+    ResultWriter results(out, cout, opts.json);
+    mt19937 rng(opts.seed);
+
+    // graph families, seeded per (type, N); grid types are grid_<rows>x<cols>
+    ThreadPool& pool = workerPool();
+    auto sparseEdges = [&](int N) {
+        return GraphGenerators::randomSparse(N, 5, cellSeed(opts.seed, "sparse", N), pool);
+    };
+    auto denseEdges = [&](int N) {
+        return GraphGenerators::randomDense(N, 0.15, cellSeed(opts.seed, "dense", N), pool);
+    };
+    auto layeredEdges = [&](int N) {
+        return GraphGenerators::layered(N, cellSeed(opts.seed, "layered", N), pool);
+    };
+    auto gridEdges = [&](int rows, int cols, const char* graphType, int N) {
+        return GraphGenerators::grid(rows, cols, cellSeed(opts.seed, graphType, N), pool);
+    };
+    auto adjacency = [&](int n, const vector<WeightedEdge>& edges) {
+        return GraphGenerators::toGraph(n, edges, pool);
     };
-    runGrid(10, 10);
-    runGrid(22, 23);
-    runGrid(32, 32);
-    runGrid(70, 72);
 
-    // worst-case layered
-    for (int i = 0; i < numSmall; i++) {
-        int N = smallSizes[i];
-        Graph g(N);
-        generateWorstCaseLayered(g);
-        runDijkstra(g, N, "worst_case", "layered", out, cout);
-        runPrim(g, N, "worst_case", "layered", out, cout);
+    // generated graphs: both layouts straight from the edge list
+    auto cell = [&](int n, const vector<WeightedEdge>& edges, const char* graphClass, const char* graphType) {
+        Graph g = GraphGenerators::toGraph(n, edges, pool);
+        CSRGraph csr = GraphGenerators::toCSR(n, edges, pool);
+        runCell(g, csr, n, graphClass, graphType, opts, rng, results, files);
+    };
+
+    // s-t query and reorder sweeps: graph files as they are read, generated families with the other sweeps
+    FileSweeps queries;
+    if (opts.sweeps) {
+        if (!openSweepFile(queries.p2p, "point_to_point.txt",
+                           "GraphClass,GraphType,N,HeapType,Mode,Queries,TimeUS,USPerQuery,Settled,SpeedUp,CI95US\n") ||
+            !openSweepFile(queries.alt, "alt.txt",
+                           "GraphClass,GraphType,N,Selection,Landmarks,PreprocessUS,TableBytes,HeapType,Queries,"
+                           "DijkstraUS,ALTUS,DijkstraSettled,ALTSettled,SpeedUp,CI95US\n") ||
+            !openSweepFile(queries.ch, "ch.txt",
+                           "GraphClass,GraphType,N,HeapType,PreprocessUS,Shortcuts,SearchGraphBytes,Queries,MeanUS,"
+                           "P50US,P90US,P99US,MaxUS,Settled,DijkstraUS,DijkstraSettled,SpeedUp\n") ||
+            !openSweepFile(queries.reorder, "reorder.txt",
+                           "GraphClass,GraphType,N,Order,ReorderUS,MeanEdgeGap,Algo,HeapType,TimeUS,SpeedUp,"
+                           "CI95US\n"))
+            return 1;
     }
-    for (int i = 0; i < numLarge; i++) {
-        int N = largeSizes[i];
-        Graph g(N);
-        generateWorstCaseLayered(g);
-        runDijkstra(g, N, "worst_case", "layered", out, cout);
-        runPrim(g, N, "worst_case", "layered", out, cout);
+
+    for (const string& path : opts.graphs)
+        if (!runGraphFile(path, opts, rng, results, files, opts.sweeps ? &queries : nullptr))
+            return 1;
+
+    // random sparse/dense
+    if (opts.wantClass("random")) {
+        for (int N : opts.sizes) {
+            cell(N, sparseEdges(N), "random", "sparse");
+            cell(N, denseEdges(N), "random", "dense");
+        }
+    }
+
+    // grids: floor(sqrt(N)) rows, enough columns to reach N
+    if (opts.wantClass("grid")) {
+        for (int N : opts.sizes) {
+            int rows = (int)sqrt(N);
+            int cols = (N + rows - 1) / rows;
+            char typeBuf[32];
+            snprintf(typeBuf, sizeof(typeBuf), "grid_%dx%d", rows, cols);
+            cell(rows * cols, gridEdges(rows, cols, typeBuf, N), "grid", typeBuf);
+        }
     }
 
+    // worst-case layered
+    if (opts.wantClass("worst_case")) {
+        for (int N : opts.sizes)
+            cell(N, layeredEdges(N), "worst_case", "layered");
+    }
+    results.finish();
     out.close();
-    cout << "Results written to results.txt\n";
+    files.fib.close();
+#ifdef HEAP_STATS
+    files.ops.close();
+    files.histograms.close();
+    cout << "Per-operation heap stats written to heap_stats.txt and heap_histograms.txt\n";
+#endif
+
+    bool anyClass = false;
+    for (const char* name : classNames)
+        if (opts.wantClass(name)) anyClass = true;
+    if (!opts.sweeps || !anyClass) {
+        cout << "Results written to " << opts.outPath << " (Fibonacci link/cut counts in fib_stats.txt"
+             << (opts.sweeps ? ", s-t queries in point_to_point.txt, alt.txt and ch.txt, "
+                               "vertex reorderings in reorder.txt" : "") << ")\n";
+        return 0;
+    }
+
+    // batch multi-source scaling, N = 5000 per family
+    ofstream batchOut;
+    if (!openSweepFile(batchOut, "batch_scaling.txt",
+                       "GraphClass,GraphType,N,HeapType,Threads,Sources,TimeUS,SpeedUp,CI95US\n"))
+        return 1;
+    {
+        const int N = 5000;
+        if (opts.wantClass("random")) {
+            Graph sparse = adjacency(N, sparseEdges(N));
+            runBatchScaling(sparse, "random", "sparse", opts, batchOut);
+            Graph dense = adjacency(N, denseEdges(N));
+            runBatchScaling(dense, "random", "dense", opts, batchOut);
+        }
+        if (opts.wantClass("grid")) {
+            Graph grid = adjacency(70 * 72, gridEdges(70, 72, "grid_70x72", N));
+            runBatchScaling(grid, "grid", "grid_70x72", opts, batchOut);
+        }
+        if (opts.wantClass("worst_case")) {
+            Graph layered = adjacency(N, layeredEdges(N));
+            runBatchScaling(layered, "worst_case", "layered", opts, batchOut);
+        }
+    }
+
+    // delta-stepping delta sweep, N = 10000 per family
+    ofstream deltaOut;
+    if (!openSweepFile(deltaOut, "delta_stepping.txt",
+                       "GraphClass,GraphType,N,Threads,Delta,TimeUS,DijkstraUS,SpeedUp,Best,CI95US\n"))
+        return 1;
+    {
+        const int N = 10000;
+        if (opts.wantClass("random")) {
+            Graph sparse = adjacency(N, sparseEdges(N));
+            runDeltaSweep(sparse, "random", "sparse", opts, deltaOut);
+        }
+        if (opts.wantClass("grid")) {
+            Graph grid = adjacency(100 * 100, gridEdges(100, 100, "grid_100x100", N));
+            runDeltaSweep(grid, "grid", "grid_100x100", opts, deltaOut);
+        }
+        if (opts.wantClass("worst_case")) {
+            Graph layered = adjacency(N, layeredEdges(N));
+            runDeltaSweep(layered, "worst_case", "layered", opts, deltaOut);
+        }
+    }
+
+    // s-t queries on the CSR layout, N = 10000 per family (undirected: the graph is its own reverse);
+    // ALT on the random sparse and grid families, CH on the grid
+    {
+        const int N = 10000;
+        if (opts.wantClass("random")) {
+            CSRGraph sparse = GraphGenerators::toCSR(N, sparseEdges(N), pool);
+            runPointToPoint(sparse, sparse, "random", "sparse", opts, queries.p2p);
+            runALTSweep(sparse, sparse, "random", "sparse", opts, queries.alt);
+        }
+        if (opts.wantClass("grid")) {
+            CSRGraph grid = GraphGenerators::toCSR(100 * 100, gridEdges(100, 100, "grid_100x100", N), pool);
+            runPointToPoint(grid, grid, "grid", "grid_100x100", opts, queries.p2p);
+            runALTSweep(grid, grid, "grid", "grid_100x100", opts, queries.alt);
+            runCHSweep(grid, "grid", "grid_100x100", opts, queries.ch);
+        }
+        if (opts.wantClass("worst_case")) {
+            CSRGraph layered = GraphGenerators::toCSR(N, layeredEdges(N), pool);
+            runPointToPoint(layered, layered, "worst_case", "layered", opts, queries.p2p);
+        }
+    }
+
+    // incremental sssp/mst under edge updates, N = 10000 random sparse and grid
+    ofstream dynamicOut;
+    if (!openSweepFile(dynamicOut, "dynamic.txt",
+                       "GraphClass,GraphType,N,HeapType,BatchSize,Batches,BatchUS,USPerUpdate,Relabelled,TreeChanges,"
+                       "DijkstraUS,PrimUS,SpeedUp\n"))
+        return 1;
+    {
+        const int N = 10000;
+        if (opts.wantClass("random")) {
+            CSRGraph sparse = GraphGenerators::toCSR(N, sparseEdges(N), pool);
+            runDynamicSweep(sparse, "random", "sparse", opts, dynamicOut);
+        }
+        if (opts.wantClass("grid")) {
+            CSRGraph grid = GraphGenerators::toCSR(100 * 100, gridEdges(100, 100, "grid_100x100", N), pool);
+            runDynamicSweep(grid, "grid", "grid_100x100", opts, dynamicOut);
+        }
+    }
+
+    // decreaseKey vs lazy-deletion mode, N = 5000 per family
+    ofstream lazyOut;
+    if (!openSweepFile(lazyOut, "lazy.txt",
+                       "GraphClass,GraphType,N,Algo,HeapType,Mode,TimeUS,Inserts,DecreaseKeys,StaleExtracts,PeakQueue,"
+                       "SpeedUp,CI95US\n"))
+        return 1;
+    {
+        const int N = 5000;
+        if (opts.wantClass("random")) {
+            CSRGraph sparse = GraphGenerators::toCSR(N, sparseEdges(N), pool);
+            runLazySweep(sparse, "random", "sparse", opts, lazyOut);
+            CSRGraph dense = GraphGenerators::toCSR(N, denseEdges(N), pool);
+            runLazySweep(dense, "random", "dense", opts, lazyOut);
+        }
+        if (opts.wantClass("grid")) {
+            CSRGraph grid = GraphGenerators::toCSR(70 * 72, gridEdges(70, 72, "grid_70x72", N), pool);
+            runLazySweep(grid, "grid", "grid_70x72", opts, lazyOut);
+        }
+        if (opts.wantClass("worst_case")) {
+            CSRGraph layered = GraphGenerators::toCSR(N, layeredEdges(N), pool);
+            runLazySweep(layered, "worst_case", "layered", opts, lazyOut);
+        }
+    }
+
+    // vertex reorderings and key widths on the same graphs, built once: N = 100000 sparse and
+    // 316x317 grid (dist[] well past L2), layered at 10000
+    ofstream keysOut;
+    if (!openSweepFile(keysOut, "keys.txt",
+                       "GraphClass,GraphType,N,HeapType,Mode,KeyBits,EntryBytes,TimeUS,SpeedUp,CI95US\n"))
+        return 1;
+    {
+        const int N = 100000;
+        if (opts.wantClass("random")) {
+            CSRGraph sparse = GraphGenerators::toCSR(N, sparseEdges(N), pool);
+            runReorderSweep(sparse, 0, 0, true, "random", "sparse", opts, queries.reorder);
+            runKeySweep(sparse, "random", "sparse", opts, keysOut);
+        }
+        if (opts.wantClass("grid")) {
+            CSRGraph grid = GraphGenerators::toCSR(316 * 317, gridEdges(316, 317, "grid_316x317", N), pool);
+            runReorderSweep(grid, 316, 317, true, "grid", "grid_316x317", opts, queries.reorder);
+            runKeySweep(grid, "grid", "grid_316x317", opts, keysOut);
+        }
+        if (opts.wantClass("worst_case")) {
+            CSRGraph layered = GraphGenerators::toCSR(N / 10, layeredEdges(N / 10), pool);
+            runReorderSweep(layered, 0, 0, true, "worst_case", "layered", opts, queries.reorder);
+            runKeySweep(layered, "worst_case", "layered", opts, keysOut);
+        }
+    }
+
+    batchOut.close();
+    deltaOut.close();
+    dynamicOut.close();
+    lazyOut.close();
+    keysOut.close();
+    queries.p2p.close();
+    queries.alt.close();
+    queries.ch.close();
+    queries.reorder.close();
+    cout << "Results written to " << opts.outPath << " (Fibonacci link/cut counts in fib_stats.txt, "
+            "batch scaling in batch_scaling.txt, delta-stepping in delta_stepping.txt, "
+            "s-t queries in point_to_point.txt, ALT in alt.txt, CH in ch.txt, edge updates in dynamic.txt, "
+            "lazy-deletion mode in lazy.txt, vertex reorderings in reorder.txt, "
+            "key widths in keys.txt)\n";
     return 0;
 }
@@ -0,0 +1,119 @@
+// replays heap traces recorded by main.exe --trace-dir against every heap, with no
+// graph in the loop. output: console csv (Algo, GraphClass, GraphType, N from the trace
+// label, then HeapType, Ops, TimeUS, MinUS, CI95US, NsPerOp, KeysMatch); TimeUS is the
+// median over the trials.
+//
+// usage: replay.exe [--warmup N] [--trials N] [--heaps LIST] trace...
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include "Benchmark.h"
+#include "HeapTrace.h"
+#include "BinaryHeap.h"
+#include "DaryHeap.h"
+#include "PackedHeap.h"
+#include "FibonacciHeap.h"
+#include "RankPairingHeap.h"
+#include "HollowHeap.h"
+#include "PairingHeap.h"
+#include "RadixHeap.h"
+#include "DialQueue.h"
+
+using namespace std;
+
+typedef double (*ReplayFn)(const HeapTrace&, long long&);
+
+// same names as main.cpp's heapColumns; a new heap needs one line here
+struct ReplayHeap {
+    const char* name;
+    ReplayFn replay;
+};
+
+static const ReplayHeap replayHeaps[] = {
+    { "Binary", replayTrace<BinaryHeap<int>> },
+    { "Pairing", replayTrace<PairingHeap<int>> },
+    { "PairingMultipass", replayTrace<MultipassPairingHeap<int>> },
+    { "PairingAux", replayTrace<AuxPairingHeap<int>> },
+    { "Fibonacci", replayTrace<FibonacciHeap<int>> },
+    { "RankPairing1", replayTrace<RankPairingHeap1<int>> },
+    { "RankPairing2", replayTrace<RankPairingHeap2<int>> },
+    { "Hollow", replayTrace<HollowHeap<int>> },
+    { "4-ary", replayTrace<DaryHeap4<int>> },
+    { "8-ary", replayTrace<DaryHeap8<int>> },
+    { "16-ary", replayTrace<DaryHeap16<int>> },
+    { "Binary-packed", replayTrace<PackedBinaryHeap<int>> },
+    { "4-ary-packed", replayTrace<PackedDaryHeap4<int>> },
+    { "8-ary-packed", replayTrace<PackedDaryHeap8<int>> },
+    { "Radix", replayTrace<RadixHeap<int>> },
+    { "Dial", replayTrace<DialQueue<int>> },
+};
+static const int numReplayHeaps = sizeof(replayHeaps) / sizeof(replayHeaps[0]);
+
+static void usage(ostream& os) {
+    os << "usage: replay.exe [--warmup N] [--trials N] [--heaps LIST] trace...\n";
+}
+
+int main(int argc, char** argv) {
+    int warmup = 1, trials = 5;
+    vector<string> heaps, paths;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            usage(cout);
+            return 0;
+        }
+        bool takesValue = arg == "--warmup" || arg == "--trials" || arg == "--heaps";
+        if (takesValue && i + 1 >= argc) {
+            cerr << "missing value for " << arg << "\n";
+            return 1;
+        }
+        if (arg == "--warmup") warmup = max(0, atoi(argv[++i]));
+        else if (arg == "--trials") trials = max(1, atoi(argv[++i]));
+        else if (arg == "--heaps") heaps = BenchOptions::split(argv[++i]);
+        else if (arg.compare(0, 2, "--") == 0) {
+            cerr << "unknown option " << arg << "\n";
+            usage(cerr);
+            return 1;
+        }
+        else paths.push_back(arg);
+    }
+    if (paths.empty()) {
+        usage(cerr);
+        return 1;
+    }
+
+    cout << "Algo,GraphClass,GraphType,N,HeapType,Ops,TimeUS,MinUS,CI95US,NsPerOp,KeysMatch\n";
+    for (const string& path : paths) {
+        HeapTrace trace;
+        string error;
+        if (!trace.load(path, error)) {
+            cerr << error << "\n";
+            return 1;
+        }
+        long long expected = trace.extractKeySum();
+        for (int h = 0; h < numReplayHeaps; h++) {
+            const ReplayHeap& heap = replayHeaps[h];
+            if (!BenchOptions::selects(heaps, heap.name)) continue;
+            vector<double> times;
+            long long keySum = 0;
+            try {
+                for (int t = -warmup; t < trials; t++) {
+                    double us = heap.replay(trace, keySum);
+                    if (t >= 0) times.push_back(us);
+                }
+            } catch (const logic_error&) {
+                // monotone queues reject prim traces; no row
+                continue;
+            }
+            TrialStats st = TrialStats::of(times);
+            char line[256];
+            snprintf(line, sizeof(line), "%.1f,%.1f,%.1f,%.2f,%d", st.medianUs, st.minUs, st.ci95Us,
+                     trace.ops.empty() ? 0.0 : 1000.0 * st.medianUs / trace.ops.size(), keySum == expected);
+            cout << trace.label << "," << heap.name << "," << trace.ops.size() << "," << line << "\n";
+        }
+    }
+    return 0;
+}